@@ -0,0 +1,285 @@
+#ifndef CONCURRENT_MAP_HPP
+# define CONCURRENT_MAP_HPP
+
+# include <functional>
+# include <memory>
+# include <pthread.h>
+# include "../utils/pair.hpp"
+# include "../utils/persistent_avl.hpp"
+# include "../iterators/persistent_iterator.hpp"
+# include "../containers/vector.hpp"
+
+namespace ft
+{
+	// Map for many readers and few writers. The tree is persistent: a write
+	// builds a new version sharing the unchanged subtrees and publishes its
+	// root, the readers never lock and never see a version being built.
+	// The writers are serialized by a mutex. A replaced root is retired and
+	// released once no reader started before the write is still reading,
+	// the readers announce the epoch they started in in a slot of the map.
+	// Past reader_slots concurrent readers, the others count themselves in
+	// a shared counter instead, and no version is released while it is not 0.
+	// A snapshot keeps one version alive for as long as it is iterated
+	template <	class Key, class T,
+				class Compare = std::less<Key>,
+				class Alloc = std::allocator<ft::pair<const Key, T> > >
+	class concurrent_map
+	{
+	private:
+		typedef				persistent_avl<Key, T, Compare, Alloc>			tree_type;
+		typedef typename	tree_type::node_type							node_type;
+	public:
+		typedef				Key												key_type;
+		typedef				T												mapped_type;
+		typedef typename	ft::pair<const key_type, mapped_type>			value_type;
+		typedef				Compare											key_compare;
+		typedef				Alloc											allocator_type;
+		typedef				persistent_iterator<const value_type, node_type>	const_iterator;
+		typedef				size_t											size_type;
+
+		static const int	reader_slots = 64;
+
+		// One version of the map, valid after the writes which follow it.
+		// The map must outlive its snapshots
+		class snapshot
+		{
+		public:
+			typedef concurrent_map::value_type		value_type;
+			typedef concurrent_map::const_iterator	const_iterator;
+			typedef concurrent_map::size_type		size_type;
+
+			snapshot(const snapshot& x) : map(x.map), root(tree_type::retain(x.root)) {}
+			snapshot& operator=(const snapshot& x) {
+				node_type *old = this->root;
+				this->root = tree_type::retain(x.root);
+				this->map->tree.release(old);
+				this->map = x.map;
+				return *this;
+			}
+			~snapshot() {
+				this->map->tree.release(this->root);
+			}
+
+			const_iterator begin() const {
+				return const_iterator(this->root);
+			}
+			const_iterator end() const {
+				return const_iterator();
+			}
+			const_iterator lower_bound(const key_type& key) const {
+				return const_iterator(this->root, key, this->map->tree.key_comp());
+			}
+			const_iterator find(const key_type& key) const {
+				const_iterator it = this->lower_bound(key);
+				if (it != this->end() && this->map->tree.key_comp()(key, it->first))
+					return this->end();
+				return it;
+			}
+			size_type count(const key_type& key) const {
+				return this->map->tree.find(this->root, key) != NULL;
+			}
+			size_type size() const {
+				return tree_type::size(this->root);
+			}
+			bool empty() const {
+				return this->root == NULL;
+			}
+
+		private:
+			friend class concurrent_map;
+
+			snapshot(const concurrent_map *map, node_type *root) : map(map), root(root) {}
+
+			const concurrent_map	*map;
+			node_type				*root;
+		};
+
+		// Constructors & Destructor
+		explicit concurrent_map(const key_compare& comp = key_compare(),
+								const allocator_type& alloc = allocator_type())
+		: tree(comp, alloc), root(NULL), epoch(1), overflowReaders(0) {
+			for (int i = 0; i < reader_slots; i++)
+				this->slots[i].epoch = 0;
+			pthread_mutex_init(&this->writeLock, NULL);
+		}
+		// No reader nor writer may still be running
+		~concurrent_map() {
+			this->tree.release(this->root);
+			for (size_type i = 0; i < this->retired.size(); i++)
+				this->tree.release(this->retired[i].root);
+			pthread_mutex_destroy(&this->writeLock);
+		}
+
+		/// READS, lock free
+		size_type size() const {
+			read_guard guard(*this);
+			return tree_type::size(guard.root);
+		}
+		bool empty() const {
+			return this->size() == 0;
+		}
+		size_type count(const key_type& key) const {
+			read_guard guard(*this);
+			return this->tree.find(guard.root, key) != NULL;
+		}
+		// The value is copied out before the version can be released
+		bool find(const key_type& key, mapped_type& value) const {
+			read_guard guard(*this);
+			const node_type *node = this->tree.find(guard.root, key);
+			if (!node)
+				return false;
+			value = node->pair.second;
+			return true;
+		}
+		snapshot get_snapshot() const {
+			read_guard guard(*this);
+			return snapshot(this, tree_type::retain(guard.root));
+		}
+
+		/// WRITES, serialized
+		bool insert(const value_type& val) {
+			write_guard guard(*this);
+			bool inserted;
+			this->publish(this->tree.insert(this->root, val, false, inserted));
+			return inserted;
+		}
+		// Returns whether the key was inserted rather than assigned
+		bool insert_or_assign(const key_type& key, const mapped_type& obj) {
+			write_guard guard(*this);
+			bool inserted;
+			this->publish(this->tree.insert(this->root, value_type(key, obj), true, inserted));
+			return inserted;
+		}
+		size_type erase(const key_type& key) {
+			write_guard guard(*this);
+			bool erased;
+			this->publish(this->tree.erase(this->root, key, erased));
+			return erased;
+		}
+		void clear() {
+			write_guard guard(*this);
+			this->publish(NULL);
+		}
+
+		// Retired versions still waiting for their readers
+		size_type retired_versions() const {
+			write_guard guard(*this);
+			return this->retired.size();
+		}
+
+		key_compare key_comp() const {
+			return this->tree.key_comp();
+		}
+		allocator_type get_allocator() const {
+			return allocator_type(this->tree.get_allocator());
+		}
+
+	private:
+		// A slot per cache line, the readers of different slots do not share lines
+		struct reader_slot {
+			unsigned long	epoch;	// 0 when free
+			char			pad[64 - sizeof(unsigned long)];
+		};
+		struct retired_root {
+			retired_root(node_type *root = NULL, unsigned long epoch = 0) : root(root), epoch(epoch) {}
+			node_type		*root;
+			unsigned long	epoch;	// First epoch whose readers cannot see root
+		};
+
+		// Claims a slot with the current epoch, or counts itself in the
+		// overflow when every slot is taken, then reads the root: every root
+		// retired after the claim waits for the guard to end
+		struct read_guard {
+			read_guard(const concurrent_map& map) : map(map), slot(NULL) {
+				unsigned long current = __atomic_load_n(&map.epoch, __ATOMIC_SEQ_CST);
+				int first = static_cast<int>((reinterpret_cast<size_t>(&current) >> 12) % reader_slots);
+				for (int n = 0; n < reader_slots && !this->slot; n++) {
+					int i = (first + n) % reader_slots;
+					unsigned long expected = 0;
+					if (__atomic_compare_exchange_n(&map.slots[i].epoch, &expected, current,
+							false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+						this->slot = &map.slots[i].epoch;
+				}
+				if (!this->slot)
+					__atomic_add_fetch(&map.overflowReaders, 1, __ATOMIC_SEQ_CST);
+				this->root = __atomic_load_n(&map.root, __ATOMIC_SEQ_CST);
+			}
+			~read_guard() {
+				if (this->slot)
+					__atomic_store_n(this->slot, 0, __ATOMIC_RELEASE);
+				else
+					__atomic_sub_fetch(&this->map.overflowReaders, 1, __ATOMIC_RELEASE);
+			}
+
+			const concurrent_map&	map;
+			unsigned long			*slot;
+			node_type				*root;
+		};
+		struct write_guard {
+			write_guard(const concurrent_map& map) : lock(&map.writeLock) {
+				pthread_mutex_lock(this->lock);
+			}
+			~write_guard() {
+				pthread_mutex_unlock(this->lock);
+			}
+
+			pthread_mutex_t	*lock;
+		};
+
+		tree_type				tree;
+		node_type				*root;			// Read atomically
+		unsigned long			epoch;			// Incremented after each publication
+		mutable reader_slot		slots[reader_slots];
+		mutable unsigned long	overflowReaders;	// Readers without a slot
+		mutable pthread_mutex_t	writeLock;
+		ft::vector<retired_root>	retired;	// Owned by the writer
+
+		concurrent_map(const concurrent_map&);
+		concurrent_map& operator=(const concurrent_map&);
+
+		// updated is owned, it is the current root when the write changed nothing.
+		// If old cannot be retired, updated is released and the map is unchanged
+		void publish(node_type *updated) {
+			if (updated == this->root) {
+				this->tree.release(updated);
+				return;
+			}
+			node_type *old = this->root;
+			if (old) {
+				try {
+					this->retired.push_back(retired_root(old));
+				} catch (...) {
+					this->tree.release(updated);
+					throw;
+				}
+			}
+			__atomic_store_n(&this->root, updated, __ATOMIC_SEQ_CST);
+			if (old)
+				this->retired.back().epoch = __atomic_add_fetch(&this->epoch, 1, __ATOMIC_SEQ_CST);
+			this->reclaim();
+		}
+		// Releases the roots retired before the oldest running reader started,
+		// none while a reader without a slot may hold any of them
+		void reclaim() {
+			if (__atomic_load_n(&this->overflowReaders, __ATOMIC_SEQ_CST))
+				return;
+			unsigned long oldest = 0;
+			for (int i = 0; i < reader_slots; i++) {
+				unsigned long e = __atomic_load_n(&this->slots[i].epoch, __ATOMIC_SEQ_CST);
+				if (e && (!oldest || e < oldest))
+					oldest = e;
+			}
+			size_type kept = 0;
+			for (size_type i = 0; i < this->retired.size(); i++) {
+				if (!oldest || this->retired[i].epoch <= oldest)
+					this->tree.release(this->retired[i].root);
+				else
+					this->retired[kept++] = this->retired[i];
+			}
+			while (this->retired.size() > kept)
+				this->retired.pop_back();
+		}
+	};
+}
+
+#endif // CONCURRENT_MAP_HPP
@@ -0,0 +1,490 @@
+#ifndef DEQUE_HPP
+# define DEQUE_HPP
+
+# include <memory>
+# include <stdexcept>
+# include <sstream>
+# include <algorithm>
+# include "../iterators/deque_iterator.hpp"
+# include "../iterators/reverse_iterator.hpp"
+# include "../utils/iterator_traits.hpp"
+# include "../utils/lexicographical_compare.hpp"
+# include "../utils/equal.hpp"
+# include "../utils/enable_if.hpp"
+# include "../utils/is_integral.hpp"
+# include "../utils/emplace_args.hpp"
+
+namespace ft
+{
+	// Elements are stored in fixed size blocks, a map (array of block pointers)
+	// points to them: pushing at either end never relocates the elements,
+	// only the map is reallocated when it is full
+	template<class T, class Alloc = std::allocator<T> >
+	class deque
+	{
+		public:
+			typedef 			T												value_type;
+			typedef 			Alloc											allocator_type;
+			typedef	typename	allocator_type::reference						reference;
+			typedef typename	allocator_type::const_reference					const_reference;
+			typedef	typename	allocator_type::pointer							pointer;
+			typedef typename	allocator_type::const_pointer					const_pointer;
+			typedef 			deque_iterator<value_type>						iterator;
+			typedef 			deque_iterator<const value_type>				const_iterator;
+			typedef 			ft::reverse_iterator<iterator>					reverse_iterator;
+			typedef				ft::reverse_iterator<const_iterator>			const_reverse_iterator;
+			typedef typename	ft::iterator_traits<iterator>::difference_type	difference_type;
+			typedef 			size_t											size_type;
+
+			// Constructors & Destructor
+			explicit deque(const allocator_type& alloc = allocator_type())			// empty container
+				: _alloc(alloc), map_alloc(alloc), map(NULL), map_size(0), spare(NULL) {
+					this->initialize();
+			}
+
+			explicit deque(size_type n, const value_type& val = value_type(),		// fill container
+				const allocator_type& alloc = allocator_type())
+				: _alloc(alloc), map_alloc(alloc), map(NULL), map_size(0), spare(NULL) {
+					this->initialize();
+					this->assign(n, val);
+			}
+
+			template <class InputIterator>
+			deque(InputIterator first, InputIterator last,						// range container
+				const allocator_type& alloc = allocator_type(),
+				typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)
+				: _alloc(alloc), map_alloc(alloc), map(NULL), map_size(0), spare(NULL) {
+					this->initialize();
+					this->assign(first, last);
+			}
+
+			deque(const deque& x) : _alloc(x._alloc), map_alloc(x._alloc), map(NULL), map_size(0), spare(NULL) {	// copy constructor
+				this->initialize();
+				this->assign(x.begin(), x.end());
+			}
+
+			~deque() {
+				this->clear();
+				this->deallocateBlock(*this->start.getNode());
+				if (this->spare)
+					this->deallocateBlock(this->spare);
+				this->map_alloc.deallocate(this->map, this->map_size);
+			}
+
+			deque& operator=(const deque& x) {	// The elements are copied with the allocator of this deque
+				if (this != &x)
+					this->assign(x.begin(), x.end());
+				return *this;
+			}
+
+			// Iterators
+			iterator begin() {
+				return this->start;
+			}
+			const_iterator begin() const {
+				return this->start;
+			}
+			iterator end() {
+				return this->finish;
+			}
+			const_iterator end() const {
+				return this->finish;
+			}
+			reverse_iterator rbegin() {
+				return reverse_iterator(this->end());
+			}
+			const_reverse_iterator rbegin() const {
+				return const_reverse_iterator(this->end());
+			}
+			reverse_iterator rend() {
+				return reverse_iterator(this->begin());
+			}
+			const_reverse_iterator rend() const {
+				return const_reverse_iterator(this->begin());
+			}
+
+			// Capacity
+			size_type size() const {
+				return this->finish - this->start;
+			}
+			size_type max_size() const {
+				return this->_alloc.max_size();
+			}
+			void resize(size_type n, value_type val = value_type()) {
+				while (this->size() > n)
+					this->pop_back();
+				while (this->size() < n)
+					this->push_back(val);
+			}
+			bool empty() const {
+				return this->start == this->finish;
+			}
+			void shrink_to_fit() {	// Release the spare block, and the map if it is mostly unused
+				if (this->spare) {
+					this->deallocateBlock(this->spare);
+					this->spare = NULL;
+				}
+				size_type nodes = this->finish.getNode() - this->start.getNode() + 1;
+				size_type newMapSize = std::max<size_type>(8, 2 * nodes);
+				if (this->map_size <= newMapSize)
+					return ;
+				map_pointer newMap = this->map_alloc.allocate(newMapSize);
+				map_pointer newStart = newMap + (newMapSize - nodes) / 2;
+				std::copy(this->start.getNode(), this->finish.getNode() + 1, newStart);
+				this->map_alloc.deallocate(this->map, this->map_size);
+				this->map = newMap;
+				this->map_size = newMapSize;
+				this->moveNodes(newStart, nodes);
+			}
+
+			// Element Access
+			reference operator[](size_type n) {
+				return this->start[n];
+			}
+			const_reference operator[](size_type n) const {
+				return this->begin()[n];
+			}
+			reference at(size_type n) {
+				if (n >= this->size())
+					throw std::out_of_range(this->out_of_range_what(n));
+				return this->start[n];
+			}
+			const_reference at(size_type n) const {
+				if (n >= this->size())
+					throw std::out_of_range(this->out_of_range_what(n));
+				return this->begin()[n];
+			}
+			reference front() {
+				return *this->start;
+			}
+			const_reference front() const {
+				return *this->start;
+			}
+			reference back() {
+				return *(this->finish - 1);
+			}
+			const_reference back() const {
+				return *(this->finish - 1);
+			}
+
+			// Modifiers
+			template <class InputIterator>
+				void assign(InputIterator first, InputIterator last,
+					typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) {
+					iterator it = this->begin();
+					for (; first != last && it != this->end(); first++, it++)
+						*it = *first;
+					if (first == last)
+						this->erase(it, this->end());
+					else
+						for (; first != last; first++)
+							this->push_back(*first);
+				}
+			void assign(size_type n, const value_type& val) {
+				iterator it = this->begin();
+				for (; n && it != this->end(); n--, it++)
+					*it = val;
+				this->erase(it, this->end());
+				for (; n; n--)
+					this->push_back(val);
+			}
+
+			void push_back(const value_type& val) {
+				this->emplaceBack(ft::emplace_args1<value_type>(val));
+			}
+			void push_front(const value_type& val) {
+				this->emplaceFront(ft::emplace_args1<value_type>(val));
+			}
+
+			// The element is constructed in place from up to 3 arguments
+			void emplace_back() {
+				this->emplaceBack(ft::emplace_args0());
+			}
+			template <class A1>
+				void emplace_back(const A1& a1) {
+					this->emplaceBack(ft::emplace_args1<A1>(a1));
+				}
+			template <class A1, class A2>
+				void emplace_back(const A1& a1, const A2& a2) {
+					this->emplaceBack(ft::emplace_args2<A1, A2>(a1, a2));
+				}
+			template <class A1, class A2, class A3>
+				void emplace_back(const A1& a1, const A2& a2, const A3& a3) {
+					this->emplaceBack(ft::emplace_args3<A1, A2, A3>(a1, a2, a3));
+				}
+			void emplace_front() {
+				this->emplaceFront(ft::emplace_args0());
+			}
+			template <class A1>
+				void emplace_front(const A1& a1) {
+					this->emplaceFront(ft::emplace_args1<A1>(a1));
+				}
+			template <class A1, class A2>
+				void emplace_front(const A1& a1, const A2& a2) {
+					this->emplaceFront(ft::emplace_args2<A1, A2>(a1, a2));
+				}
+			template <class A1, class A2, class A3>
+				void emplace_front(const A1& a1, const A2& a2, const A3& a3) {
+					this->emplaceFront(ft::emplace_args3<A1, A2, A3>(a1, a2, a3));
+				}
+
+			void pop_back() {
+				if (this->finish.getCur() == this->finish.getFirst()) {	// The emptied block is released
+					this->releaseBlock(this->finish.getFirst());
+					this->finish.setNode(this->finish.getNode() - 1);
+					this->finish.setCur(this->finish.getLast());
+				}
+				this->finish.setCur(this->finish.getCur() - 1);
+				this->_alloc.destroy(this->finish.getCur());
+			}
+			void pop_front() {
+				this->_alloc.destroy(this->start.getCur());
+				if (this->start.getCur() == this->start.getLast() - 1) {	// The emptied block is released
+					this->releaseBlock(this->start.getFirst());
+					this->start.setNode(this->start.getNode() + 1);
+					this->start.setCur(this->start.getFirst());
+				}
+				else
+					this->start.setCur(this->start.getCur() + 1);
+			}
+
+			// insert/erase work on the nearest end: the new elements are pushed
+			// there, then rotated to their position
+			iterator insert(iterator position, const value_type& val) {
+				difference_type index = position - this->begin();
+				this->insert(position, 1, val);
+				return this->begin() + index;
+			}
+			void insert(iterator position, size_type n, const value_type& val) {
+				difference_type index = position - this->begin();
+				if (static_cast<size_type>(index) < this->size() / 2) {
+					for (size_type i = 0; i < n; i++)
+						this->push_front(val);
+					std::rotate(this->begin(), this->begin() + n, this->begin() + n + index);
+				} else {
+					difference_type oldSize = this->size();
+					for (size_type i = 0; i < n; i++)
+						this->push_back(val);
+					std::rotate(this->begin() + index, this->begin() + oldSize, this->end());
+				}
+			}
+			template <class InputIterator>
+				void insert(iterator position, InputIterator first, InputIterator last,
+					typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) {
+					difference_type index = position - this->begin();
+					difference_type oldSize = this->size();
+					if (static_cast<size_type>(index) < this->size() / 2) {
+						for (; first != last; first++)
+							this->push_front(*first);
+						difference_type n = this->size() - oldSize;
+						std::reverse(this->begin(), this->begin() + n);
+						std::rotate(this->begin(), this->begin() + n, this->begin() + n + index);
+					} else {
+						for (; first != last; first++)
+							this->push_back(*first);
+						std::rotate(this->begin() + index, this->begin() + oldSize, this->end());
+					}
+				}
+
+			iterator erase(iterator position) {
+				return this->erase(position, position + 1);
+			}
+			iterator erase(iterator first, iterator last) {
+				difference_type n = last - first;
+				difference_type index = first - this->begin();
+				if (n == 0)
+					return first;
+				if (static_cast<size_type>(index) < (this->size() - n) / 2) {	// Offset the front to the right
+					std::copy_backward(this->begin(), first, last);
+					for (difference_type i = 0; i < n; i++)
+						this->pop_front();
+				} else {														// Offset the back to the left
+					std::copy(last, this->end(), first);
+					for (difference_type i = 0; i < n; i++)
+						this->pop_back();
+				}
+				return this->begin() + index;
+			}
+
+			void swap(deque& x) {	// The allocators follow their memory
+				std::swap(this->_alloc, x._alloc);
+				std::swap(this->map_alloc, x.map_alloc);
+				std::swap(this->map, x.map);
+				std::swap(this->map_size, x.map_size);
+				std::swap(this->start, x.start);
+				std::swap(this->finish, x.finish);
+				std::swap(this->spare, x.spare);
+			}
+
+			void clear() {
+				this->erase(this->begin(), this->end());
+			}
+
+			// Allocator
+			allocator_type get_allocator() const {
+				return this->_alloc;
+			}
+
+		private:
+			typedef typename	allocator_type::template rebind<pointer>::other	map_allocator_type;
+			typedef				pointer*										map_pointer;
+
+			allocator_type		_alloc;
+			map_allocator_type	map_alloc;
+			map_pointer			map;		// Pointers to the blocks, the used ones are [start.node, finish.node]
+			size_type			map_size;
+			iterator			start;
+			iterator			finish;
+			pointer				spare;		// Last released block, kept for the next push
+
+			// Get the error message for out_of_range exception
+			std::string out_of_range_what(size_type n) const {
+				std::stringstream ss;
+				ss << "deque::_M_range_check: __n (which is " << n
+					<< ") >= this->size() (which is " << this->size() << ")";
+				return ss.str();
+			}
+
+			// The end of the deque (finish.cur) is always inside an allocated block
+			template <class Args>
+				void emplaceBack(const Args& args) {
+					if (this->finish.getCur() != this->finish.getLast() - 1) {
+						args(this->finish.getCur());
+						this->finish.setCur(this->finish.getCur() + 1);
+						return ;
+					}
+					this->reserveMap(1, false);
+					*(this->finish.getNode() + 1) = this->allocateBlock();
+					try {
+						args(this->finish.getCur());
+					} catch (...) {
+						this->releaseBlock(*(this->finish.getNode() + 1));
+						throw;
+					}
+					this->finish.setNode(this->finish.getNode() + 1);
+					this->finish.setCur(this->finish.getFirst());
+				}
+			template <class Args>
+				void emplaceFront(const Args& args) {
+					if (this->start.getCur() != this->start.getFirst()) {
+						args(this->start.getCur() - 1);
+						this->start.setCur(this->start.getCur() - 1);
+						return ;
+					}
+					this->reserveMap(1, true);
+					*(this->start.getNode() - 1) = this->allocateBlock();
+					try {
+						args(*(this->start.getNode() - 1) + deque_block<T>::size - 1);
+					} catch (...) {
+						this->releaseBlock(*(this->start.getNode() - 1));
+						throw;
+					}
+					this->start.setNode(this->start.getNode() - 1);
+					this->start.setCur(this->start.getLast() - 1);
+				}
+
+			// Allocation Manager, a push/pop cycle at a block boundary reuses the spare block
+			pointer allocateBlock() {
+				if (this->spare) {
+					pointer block = this->spare;
+					this->spare = NULL;
+					return block;
+				}
+				return this->_alloc.allocate(deque_block<T>::size);
+			}
+			void releaseBlock(pointer block) {
+				if (this->spare)
+					this->deallocateBlock(this->spare);
+				this->spare = block;
+			}
+			void deallocateBlock(pointer block) {
+				this->_alloc.deallocate(block, deque_block<T>::size);
+			}
+			void initialize() {	// A map of 8 blocks, the first block is allocated in its middle
+				this->map_size = 8;
+				this->map = this->map_alloc.allocate(this->map_size);
+				map_pointer node = this->map + this->map_size / 2;
+				*node = this->allocateBlock();
+				this->start = iterator(*node + deque_block<T>::size / 2, node);
+				this->finish = this->start;
+			}
+			// Makes room for nodesToAdd block pointers before start or after finish:
+			// the used pointers are recentered, or copied to a map twice as big
+			void reserveMap(size_type nodesToAdd, bool atFront) {
+				if (atFront && static_cast<size_type>(this->start.getNode() - this->map) >= nodesToAdd)
+					return ;
+				if (!atFront && static_cast<size_type>(this->map + this->map_size - this->finish.getNode() - 1) >= nodesToAdd)
+					return ;
+				size_type oldNodes = this->finish.getNode() - this->start.getNode() + 1;
+				size_type newNodes = oldNodes + nodesToAdd;
+				map_pointer newStart;
+				if (this->map_size > 2 * newNodes) {
+					newStart = this->map + (this->map_size - newNodes) / 2 + (atFront ? nodesToAdd : 0);
+					if (newStart < this->start.getNode())
+						std::copy(this->start.getNode(), this->finish.getNode() + 1, newStart);
+					else
+						std::copy_backward(this->start.getNode(), this->finish.getNode() + 1, newStart + oldNodes);
+				} else {
+					size_type newMapSize = this->map_size + std::max(this->map_size, nodesToAdd) + 2;
+					map_pointer newMap = this->map_alloc.allocate(newMapSize);
+					newStart = newMap + (newMapSize - newNodes) / 2 + (atFront ? nodesToAdd : 0);
+					std::copy(this->start.getNode(), this->finish.getNode() + 1, newStart);
+					this->map_alloc.deallocate(this->map, this->map_size);
+					this->map = newMap;
+					this->map_size = newMapSize;
+				}
+				this->moveNodes(newStart, oldNodes);
+			}
+			// Points start and finish to the block pointers copied to newStart
+			void moveNodes(map_pointer newStart, size_type nodes) {
+				pointer startCur = this->start.getCur();
+				pointer finishCur = this->finish.getCur();
+				this->start.setNode(newStart);
+				this->start.setCur(startCur);
+				this->finish.setNode(newStart + nodes - 1);
+				this->finish.setCur(finishCur);
+			}
+	};
+
+	// Relational Operators
+	template <class T, class Alloc>
+	bool operator==(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+		if (lhs.size() != rhs.size())
+			return false;
+		return ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+	template <class T, class Alloc>
+	bool operator!=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+		return !(lhs == rhs);
+	}
+	template <class T, class Alloc>
+	bool operator<(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+	template <class T, class Alloc>
+	bool operator<=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+		return !(rhs < lhs);
+	}
+	template <class T, class Alloc>
+	bool operator>(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+		return rhs < lhs;
+	}
+	template <class T, class Alloc>
+	bool operator>=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+		return !(lhs < rhs);
+	}
+
+	// Swap non member
+	template <class T, class Alloc>
+	void swap(deque<T, Alloc>& x, deque<T, Alloc>& y) {
+		x.swap(y);
+	}
+
+	// See stack.hpp
+	template <class T, class Alloc>
+	void shrink_to_fit(deque<T, Alloc>& x) {
+		x.shrink_to_fit();
+	}
+}
+
+#endif // DEQUE_HPP
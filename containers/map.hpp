@@ -9,6 +9,9 @@
 # include "../iterators/map_iterator.hpp"
  # include "../iterators/reverse_iterator.hpp"
 # include "../utils/AVL.hpp"
+# include "../utils/node_handle.hpp"
+# include "../utils/is_transparent.hpp"
+# include "../utils/enable_if.hpp"
 # include "../containers/vector.hpp"
 
 // for mli tester
@@ -40,6 +43,8 @@ namespace ft
 		typedef typename	ft::reverse_iterator<const_iterator>			const_reverse_iterator;
 		typedef typename	ft::iterator_traits<iterator>::difference_type	difference_type;
 		typedef				size_t											size_type;
+		typedef				map_node_handle<key_type, mapped_type, node_type,
+								typename avl_type::allocator_type>			node_handle;
 		
 		class value_compare : std::binary_function<value_type, value_type, bool> {
 			friend class map;
@@ -66,13 +71,10 @@ namespace ft
 			const allocator_type& alloc = allocator_type())
 		: avl(comp, alloc) {
 			for (InputIterator it = first; it != last; it++)
-				if (!this->avl.find(it->first))
-					avl.insert(*it);
+				this->avl.insert(*it);
 		}
 
-		map(const map& x) : avl(x.avl) {
-			*this = x;
-		}
+		map(const map& x) : avl(x.avl) {}
 
 		map& operator=(const map& x) {
 			this->avl = x.avl;
@@ -127,13 +129,9 @@ namespace ft
 
 		// Element access
 		mapped_type& operator[](const key_type& k) {
-			node_type *p = this->avl.find(k);
-			if (!p) {
-				this->avl.insert(ft::make_pair(k, mapped_type()));
-				p = this->avl.find(k);
-			}
-			value_type& val = p->pair;
-			return val.second;
+			node_type *p;
+			this->avl.insertKey(k, p);
+			return p->pair.second;
 		}
 		mapped_type& at(const key_type& k) {
 			node_type *p = this->avl.find(k);
@@ -150,48 +148,131 @@ namespace ft
 			return val.second;
 		}
 
+		// Heterogeneous lookups, if key_compare is transparent (see is_transparent.hpp)
+		// A key_type is only built when operator[] inserts a new element
+		template <class K>
+		typename ft::enable_if<ft::is_transparent<key_compare, K>::value, mapped_type&>::type
+		operator[](const K& k) {
+			node_type *p;
+			this->avl.insertKey(k, p);
+			return p->pair.second;
+		}
+		template <class K>
+		typename ft::enable_if<ft::is_transparent<key_compare, K>::value, mapped_type&>::type
+		at(const K& k) {
+			node_type *p = this->avl.find(k);
+			if (!p)
+				throw std::out_of_range("map::at");
+			return p->pair.second;
+		}
+		template <class K>
+		typename ft::enable_if<ft::is_transparent<key_compare, K>::value, const mapped_type&>::type
+		at(const K& k) const {
+			node_type *p = this->avl.find(k);
+			if (!p)
+				throw std::out_of_range("map::at");
+			return p->pair.second;
+		}
+
 		// Modifiers
 		ft::pair<iterator, bool> insert(const value_type& val) {
-			node_type *p = this->avl.find(val.first);
-			bool newElement = (p == NULL);
-			if (newElement) {
-				this->avl.insert(val);
-				p = this->avl.find(val.first);
-			}
+			node_type *p;
+			bool newElement = this->avl.insert(val, p);
 			return ft::make_pair(iterator(p), newElement);
 		}
-		iterator insert(iterator position, const value_type& val) {
-			value_type pos_val = *position;
+		iterator insert(iterator position, const value_type& val) {	// The hint is not needed by the single descent
+			(void)position;
 			node_type *p;
-			if ((p = this->avl.find(val.first)))
-				return iterator(p);
-			p = this->avl.find(pos_val.first);
-			if (p) {
-				bool goodHint = true;
-				key_compare comp = this->key_comp();
-				position--;
-				if (comp(val.first, position->first))
-					goodHint = false;
-				position++;
-				position++;
-				if (comp(position->first, val.first))
-					goodHint = false;
-				position--;
-				if (goodHint) {
-					avl.insert(val, &p);
-					p = avl.find(val.first);
-					return iterator(p);
-				}
-			}
-			this->avl.insert(val);
-			p = this->avl.find(val.first);
+			this->avl.insert(val, p);
 			return iterator(p);
 		}
 		template <class InputIterator>
 		void insert(InputIterator first, InputIterator last) {
 			for (InputIterator it = first; it != last; it++)
-				if (!this->avl.find(it->first))
-					this->avl.insert(*it);
+				this->avl.insert(*it);
+		}
+		// The pair is constructed in the node from (k, m): m is not copied into a
+		// temporary value_type first, and nothing is built if k is already there
+		template <class M>
+		ft::pair<iterator, bool> emplace(const key_type& k, const M& m) {
+			node_type *p;
+			bool newElement = this->avl.emplace(k, m, p);
+			return ft::make_pair(iterator(p), newElement);
+		}
+		template <class M>
+		iterator emplace_hint(iterator position, const key_type& k, const M& m) {
+			(void)position;
+			node_type *p;
+			this->avl.emplace(k, m, p);
+			return iterator(p);
+		}
+		// Upserts, in a single descent: try_emplace builds the mapped value in
+		// the node from up to 3 arguments, only if k is missing, where
+		// insert_or_assign assigns obj to the mapped value of an existing k
+		ft::pair<iterator, bool> try_emplace(const key_type& k) {
+			return this->tryEmplace(k, ft::emplace_args0());
+		}
+		template <class A1>
+		ft::pair<iterator, bool> try_emplace(const key_type& k, const A1& a1) {
+			return this->tryEmplace(k, ft::emplace_args1<A1>(a1));
+		}
+		template <class A1, class A2>
+		ft::pair<iterator, bool> try_emplace(const key_type& k, const A1& a1, const A2& a2) {
+			return this->tryEmplace(k, ft::emplace_args2<A1, A2>(a1, a2));
+		}
+		template <class A1, class A2, class A3>
+		ft::pair<iterator, bool> try_emplace(const key_type& k, const A1& a1, const A2& a2, const A3& a3) {
+			return this->tryEmplace(k, ft::emplace_args3<A1, A2, A3>(a1, a2, a3));
+		}
+		iterator try_emplace(iterator position, const key_type& k) {
+			(void)position;
+			return this->tryEmplace(k, ft::emplace_args0()).first;
+		}
+		template <class A1>
+		iterator try_emplace(iterator position, const key_type& k, const A1& a1) {
+			(void)position;
+			return this->tryEmplace(k, ft::emplace_args1<A1>(a1)).first;
+		}
+		template <class A1, class A2>
+		iterator try_emplace(iterator position, const key_type& k, const A1& a1, const A2& a2) {
+			(void)position;
+			return this->tryEmplace(k, ft::emplace_args2<A1, A2>(a1, a2)).first;
+		}
+		template <class A1, class A2, class A3>
+		iterator try_emplace(iterator position, const key_type& k, const A1& a1, const A2& a2, const A3& a3) {
+			(void)position;
+			return this->tryEmplace(k, ft::emplace_args3<A1, A2, A3>(a1, a2, a3)).first;
+		}
+		template <class M>
+		ft::pair<iterator, bool> insert_or_assign(const key_type& k, const M& obj) {
+			node_type *p;
+			bool newElement = this->avl.emplace(k, obj, p);
+			if (!newElement)
+				p->pair.second = obj;
+			return ft::make_pair(iterator(p), newElement);
+		}
+		template <class M>
+		iterator insert_or_assign(iterator position, const key_type& k, const M& obj) {
+			(void)position;
+			return this->insert_or_assign(k, obj).first;
+		}
+
+		// Relinks the node, nh is emptied on success. The handle moves its node
+		// on copy, as auto_ptr does, so the result of extract() can be inserted
+		ft::pair<iterator, bool> insert(const node_handle& nh) {
+			if (nh.empty())
+				return ft::make_pair(this->end(), false);
+			node_type *p;
+			if (!(nh.alloc == this->avl.get_alloc())) { // The node cannot change allocator: its value is copied
+				bool inserted = this->avl.insert(nh.node->pair, p);
+				if (inserted)
+					node_handle freed(nh);
+				return ft::make_pair(iterator(p), inserted);
+			}
+			bool inserted = this->avl.link(nh.node, nh.alloc, p);
+			if (inserted)
+				nh.release();
+			return ft::make_pair(iterator(p), inserted);
 		}
 
 		void erase(iterator position) {
@@ -202,12 +283,15 @@ namespace ft
 				return 1;
 			return 0;
 		}
-		void erase(iterator first, iterator last) {
-			ft::vector<key_type> v;
-			for (iterator it = first; it != last; it++)
-				v.push_back(it->first);
-			for (typename ft::vector<key_type>::iterator it = v.begin(); it != v.end(); it++)
-				this->avl.erase(*it);
+		void erase(iterator first, iterator last) {	// Split & join, the elements are not rebalanced one by one
+			this->avl.eraseRange(first.getNode(), last.getNode());
+		}
+
+		node_handle extract(iterator position) {	// Unlinks the node, without deallocation nor copy
+			return node_handle(this->avl.extract(position->first), this->avl.get_alloc());
+		}
+		node_handle extract(const key_type& k) {
+			return node_handle(this->avl.extract(k), this->avl.get_alloc());
 		}
 
 		void swap(map& x) {
@@ -218,6 +302,20 @@ namespace ft
 			this->avl.clear();
 		}
 
+		void merge(map& source) {	// Moves the elements of source whose key is not in this map, copies them if the allocators differ
+			this->avl.merge(source.avl);
+		}
+
+		map split(const key_type& k) {	// Moves the elements whose key is >= k to a new map
+			map upper(this->key_comp(), this->get_allocator());
+			this->avl.splitInto(k, upper.avl);
+			return upper;
+		}
+
+		void splice(map& other) {	// Moves other into this map, O(log n) if their keys do not overlap and the allocators are equal
+			this->avl.splice(other.avl);
+		}
+
 		// Observers
 		key_compare key_comp() const {
 			return this->avl.get_comp();
@@ -237,6 +335,8 @@ namespace ft
 		}
 		const_iterator find(const key_type& k) const {
 			node_type *p = this->avl.find(k);
+			if (!p)
+				return this->end();
 			return const_iterator(p);
 		}
 
@@ -247,33 +347,17 @@ namespace ft
 		}
 
 		iterator lower_bound(const key_type& k) {
-			key_compare comp = this->key_comp();
-			for (iterator it = this->begin(); it != this->end(); it++)
-				if (!comp(it->first, k))
-					return it;
-			return this->end();
+			return iterator(this->avl.lowerBound(k));
 		}
 		const_iterator lower_bound(const key_type& k) const {
-			key_compare comp = this->key_comp();
-			for (const_iterator it = this->begin(); it != this->end(); it++)
-				if (!comp(it->first, k))
-					return it;
-			return this->end();
+			return const_iterator(this->avl.lowerBound(k));
 		}
 
 		iterator upper_bound(const key_type& k) {
-			key_compare comp = this->key_comp();
-			for (iterator it = this->begin(); it != this->end(); it++)
-				if (comp(k, it->first))
-					return it;
-			return this->end();
+			return iterator(this->avl.upperBound(k));
 		}
 		const_iterator upper_bound(const key_type& k) const {
-			key_compare comp = this->key_comp();
-			for (const_iterator it = this->begin(); it != this->end(); it++)
-				if (comp(k, it->first))
-					return it;
-			return this->end();
+			return const_iterator(this->avl.upperBound(k));
 		}
 
 		ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
@@ -283,11 +367,102 @@ namespace ft
 			return ft::make_pair(this->lower_bound(k), this->upper_bound(k));
 		}
 
+		// Heterogeneous operations, if key_compare is transparent
+		template <class K>
+		typename ft::enable_if<ft::is_transparent<key_compare, K>::value, iterator>::type
+		find(const K& k) {
+			node_type *p = this->avl.find(k);
+			if (!p)
+				return this->end();
+			return iterator(p);
+		}
+		template <class K>
+		typename ft::enable_if<ft::is_transparent<key_compare, K>::value, const_iterator>::type
+		find(const K& k) const {
+			node_type *p = this->avl.find(k);
+			if (!p)
+				return this->end();
+			return const_iterator(p);
+		}
+
+		template <class K>
+		typename ft::enable_if<ft::is_transparent<key_compare, K>::value, size_type>::type
+		count(const K& k) const {
+			if (this->avl.find(k))
+				return 1;
+			return 0;
+		}
+
+		template <class K>
+		typename ft::enable_if<ft::is_transparent<key_compare, K>::value, iterator>::type
+		lower_bound(const K& k) {
+			return iterator(this->avl.lowerBound(k));
+		}
+		template <class K>
+		typename ft::enable_if<ft::is_transparent<key_compare, K>::value, const_iterator>::type
+		lower_bound(const K& k) const {
+			return const_iterator(this->avl.lowerBound(k));
+		}
+
+		template <class K>
+		typename ft::enable_if<ft::is_transparent<key_compare, K>::value, iterator>::type
+		upper_bound(const K& k) {
+			return iterator(this->avl.upperBound(k));
+		}
+		template <class K>
+		typename ft::enable_if<ft::is_transparent<key_compare, K>::value, const_iterator>::type
+		upper_bound(const K& k) const {
+			return const_iterator(this->avl.upperBound(k));
+		}
+
+		template <class K>
+		typename ft::enable_if<ft::is_transparent<key_compare, K>::value,
+								ft::pair<iterator, iterator> >::type
+		equal_range(const K& k) {
+			return ft::make_pair(this->lower_bound(k), this->upper_bound(k));
+		}
+		template <class K>
+		typename ft::enable_if<ft::is_transparent<key_compare, K>::value,
+								ft::pair<const_iterator, const_iterator> >::type
+		equal_range(const K& k) const {
+			return ft::make_pair(this->lower_bound(k), this->upper_bound(k));
+		}
+
 		// Allocator
 		allocator_type get_allocator() const {
 			return this->avl.get_alloc();
 		}
+
+# ifdef FT_AVL_STATS
+		// Comparisons, rotations, node allocations and parent climbs of all
+		// the trees since the last reset, see AVL.hpp
+		static const ft::avl_counters& hot_path_counters() {
+			return ft::avl_counters::global();
+		}
+		static void reset_hot_path_counters() {
+			ft::avl_counters::global().reset();
+		}
+# endif
+
+# ifndef NDEBUG
+		// Debug builds: checks of the AVL tree and its shape, see AVL.hpp
+		typedef typename	avl_type::shape_stats							shape_stats;
+
+		const char *validate() const {
+			return this->avl.validate();
+		}
+		shape_stats shape() const {
+			return this->avl.shape();
+		}
+# endif
 		
+		template <class Key2, class T2, class Compare2, class Alloc2>
+		friend map<Key2, T2, Compare2, Alloc2> set_union(const map<Key2, T2, Compare2, Alloc2>& lhs, const map<Key2, T2, Compare2, Alloc2>& rhs);
+		template <class Key2, class T2, class Compare2, class Alloc2>
+		friend map<Key2, T2, Compare2, Alloc2> set_intersection(const map<Key2, T2, Compare2, Alloc2>& lhs, const map<Key2, T2, Compare2, Alloc2>& rhs);
+		template <class Key2, class T2, class Compare2, class Alloc2>
+		friend map<Key2, T2, Compare2, Alloc2> set_difference(const map<Key2, T2, Compare2, Alloc2>& lhs, const map<Key2, T2, Compare2, Alloc2>& rhs);
+
 		template <class Key2, class T2, class Compare2, class Alloc2>
 		friend bool operator==(const map<Key2, T2, Compare2, Alloc2>& lhs, const map<Key2, T2, Compare2, Alloc2>& rhs);
 		template <class Key2, class T2, class Compare2, class Alloc2>
@@ -303,6 +478,13 @@ namespace ft
 
 	private:
 		avl_type avl;
+
+		template <class Args>
+		ft::pair<iterator, bool> tryEmplace(const key_type& k, const Args& args) {
+			node_type *p;
+			bool newElement = this->avl.tryEmplace(k, args, p);
+			return ft::make_pair(iterator(p), newElement);
+		}
 	};
 
 	template <class Key, class T, class Compare, class Alloc>
@@ -336,6 +518,34 @@ namespace ft
 		return lhs.avl >= rhs.avl;
 	}
 
+	// Set operations, linear in lhs.size() + rhs.size()
+	// On equal keys, the element of lhs is kept
+	template <class Key, class T, class Compare, class Alloc>
+	map<Key,T,Compare,Alloc> set_union(const map<Key,T,Compare,Alloc>& lhs,
+										const map<Key,T,Compare,Alloc>& rhs) {
+		typedef AVL<Key, T, Compare, Alloc> avl_type;
+		map<Key,T,Compare,Alloc> ret(lhs.key_comp(), lhs.get_allocator());
+		ret.avl.setOperation(lhs.avl, rhs.avl,
+			avl_type::ONLY_LHS | avl_type::ONLY_RHS | avl_type::BOTH);
+		return ret;
+	}
+	template <class Key, class T, class Compare, class Alloc>
+	map<Key,T,Compare,Alloc> set_intersection(const map<Key,T,Compare,Alloc>& lhs,
+												const map<Key,T,Compare,Alloc>& rhs) {
+		typedef AVL<Key, T, Compare, Alloc> avl_type;
+		map<Key,T,Compare,Alloc> ret(lhs.key_comp(), lhs.get_allocator());
+		ret.avl.setOperation(lhs.avl, rhs.avl, avl_type::BOTH);
+		return ret;
+	}
+	template <class Key, class T, class Compare, class Alloc>
+	map<Key,T,Compare,Alloc> set_difference(const map<Key,T,Compare,Alloc>& lhs,
+											const map<Key,T,Compare,Alloc>& rhs) {
+		typedef AVL<Key, T, Compare, Alloc> avl_type;
+		map<Key,T,Compare,Alloc> ret(lhs.key_comp(), lhs.get_allocator());
+		ret.avl.setOperation(lhs.avl, rhs.avl, avl_type::ONLY_LHS);
+		return ret;
+	}
+
 	template< class Key, class T, class Compare, class Alloc >
 	void swap( map<Key,T,Compare,Alloc>& lhs,
 	           map<Key,T,Compare,Alloc>& rhs ) {
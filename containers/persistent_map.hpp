@@ -0,0 +1,213 @@
+#ifndef PERSISTENT_MAP_HPP
+# define PERSISTENT_MAP_HPP
+
+# include <functional>
+# include <memory>
+# include <stdexcept>
+# include "../utils/pair.hpp"
+# include "../utils/equal.hpp"
+# include "../utils/lexicographical_compare.hpp"
+# include "../utils/persistent_avl.hpp"
+# include "../iterators/persistent_iterator.hpp"
+
+namespace ft
+{
+	// Map whose copies share their nodes: a copy is O(1), an update copies
+	// the path to the changed node, O(log n) time and memory, and leaves the
+	// other copies as they were. Keeping a version is copying the map.
+	// The elements are never changed in place, the iterators are constant
+	// and stay valid while a map holds their version. The copies can be
+	// used from different threads if Alloc allows it
+	template <	class Key, class T,
+				class Compare = std::less<Key>,
+				class Alloc = std::allocator<ft::pair<const Key, T> > >
+	class persistent_map
+	{
+	private:
+		typedef				persistent_avl<Key, T, Compare, Alloc>			tree_type;
+		typedef typename	tree_type::node_type							node_type;
+	public:
+		typedef				Key												key_type;
+		typedef				T												mapped_type;
+		typedef typename	ft::pair<const key_type, mapped_type>			value_type;
+		typedef				Compare											key_compare;
+		typedef				Alloc											allocator_type;
+		typedef typename	allocator_type::const_reference					reference;
+		typedef typename	allocator_type::const_reference					const_reference;
+		typedef				persistent_iterator<const value_type, node_type>	const_iterator;
+		typedef				const_iterator									iterator;
+		typedef				ptrdiff_t										difference_type;
+		typedef				size_t											size_type;
+
+		// Constructors & Destructor
+		explicit persistent_map(const key_compare& comp = key_compare(),
+								const allocator_type& alloc = allocator_type())
+		: tree(comp, alloc), root(NULL) {}
+
+		template <class InputIterator>
+		persistent_map(InputIterator first, InputIterator last,
+						const key_compare& comp = key_compare(),
+						const allocator_type& alloc = allocator_type())
+		: tree(comp, alloc), root(NULL) {
+			for (; first != last; first++)
+				this->insert(*first);
+		}
+
+		persistent_map(const persistent_map& x) : tree(x.tree), root(tree_type::retain(x.root)) {}
+
+		// The nodes of x come with the comparator that ordered them and the
+		// allocator that will free them
+		persistent_map& operator=(const persistent_map& x) {
+			node_type *root = tree_type::retain(x.root);
+			this->tree.release(this->root);
+			this->tree = x.tree;
+			this->root = root;
+			return *this;
+		}
+
+		~persistent_map() {
+			this->tree.release(this->root);
+		}
+
+		// Iterators
+		const_iterator begin() const {
+			return const_iterator(this->root);
+		}
+		const_iterator end() const {
+			return const_iterator();
+		}
+
+		// Capacity
+		bool empty() const {
+			return this->root == NULL;
+		}
+		size_type size() const {
+			return tree_type::size(this->root);
+		}
+		size_type max_size() const {
+			return this->tree.get_allocator().max_size();
+		}
+
+		// Element access
+		const mapped_type& at(const key_type& k) const {
+			const node_type *p = this->tree.find(this->root, k);
+			if (!p)
+				throw std::out_of_range("persistent_map::at");
+			return p->pair.second;
+		}
+
+		// Modifiers, the other copies keep their version. Returns whether the
+		// key was inserted
+		bool insert(const value_type& val) {
+			bool inserted;
+			this->update(this->tree.insert(this->root, val, false, inserted));
+			return inserted;
+		}
+		bool insert_or_assign(const key_type& k, const mapped_type& obj) {
+			bool inserted;
+			this->update(this->tree.insert(this->root, value_type(k, obj), true, inserted));
+			return inserted;
+		}
+		size_type erase(const key_type& k) {
+			bool erased;
+			this->update(this->tree.erase(this->root, k, erased));
+			return erased;
+		}
+
+		void swap(persistent_map& x) {
+			node_type *tmp = this->root;
+			this->root = x.root;
+			x.root = tmp;
+			tree_type tree(this->tree);
+			this->tree = x.tree;
+			x.tree = tree;
+		}
+
+		void clear() {
+			this->tree.release(this->root);
+			this->root = NULL;
+		}
+
+		// Observers
+		key_compare key_comp() const {
+			return this->tree.key_comp();
+		}
+		allocator_type get_allocator() const {
+			return allocator_type(this->tree.get_allocator());
+		}
+
+		// Lookup
+		const_iterator find(const key_type& k) const {
+			const_iterator it = this->lower_bound(k);
+			if (it != this->end() && this->tree.key_comp()(k, it->first))
+				return this->end();
+			return it;
+		}
+		size_type count(const key_type& k) const {
+			return this->tree.find(this->root, k) != NULL;
+		}
+		const_iterator lower_bound(const key_type& k) const {
+			return const_iterator(this->root, k, this->tree.key_comp());
+		}
+		const_iterator upper_bound(const key_type& k) const {
+			return const_iterator(this->root, k, this->tree.key_comp(), true);
+		}
+
+		// Copies of one version share their root, they are equal in O(1)
+		bool same_version(const persistent_map& x) const {
+			return this->root == x.root;
+		}
+
+	private:
+		tree_type	tree;
+		node_type	*root;
+
+		// updated is owned, it is root when the update changed nothing
+		void update(node_type *updated) {
+			node_type *old = this->root;
+			this->root = updated;
+			this->tree.release(old);
+		}
+	};
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator==(const persistent_map<Key,T,Compare,Alloc>& lhs,
+					const persistent_map<Key,T,Compare,Alloc>& rhs) {
+		if (lhs.same_version(rhs))
+			return true;
+		return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator!=(const persistent_map<Key,T,Compare,Alloc>& lhs,
+					const persistent_map<Key,T,Compare,Alloc>& rhs) {
+		return !(lhs == rhs);
+	}
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator<(const persistent_map<Key,T,Compare,Alloc>& lhs,
+					const persistent_map<Key,T,Compare,Alloc>& rhs) {
+		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator<=(const persistent_map<Key,T,Compare,Alloc>& lhs,
+					const persistent_map<Key,T,Compare,Alloc>& rhs) {
+		return !(rhs < lhs);
+	}
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator>(const persistent_map<Key,T,Compare,Alloc>& lhs,
+					const persistent_map<Key,T,Compare,Alloc>& rhs) {
+		return rhs < lhs;
+	}
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator>=(const persistent_map<Key,T,Compare,Alloc>& lhs,
+					const persistent_map<Key,T,Compare,Alloc>& rhs) {
+		return !(lhs < rhs);
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	void swap(persistent_map<Key,T,Compare,Alloc>& lhs,
+			  persistent_map<Key,T,Compare,Alloc>& rhs) {
+		lhs.swap(rhs);
+	}
+}
+
+#endif // PERSISTENT_MAP_HPP
@@ -0,0 +1,220 @@
+#ifndef SHARDED_MAP_HPP
+# define SHARDED_MAP_HPP
+
+# include <functional>
+# include <memory>
+# include <new>
+# include <pthread.h>
+# include "../utils/pair.hpp"
+# include "../utils/hash.hpp"
+# include "../containers/map.hpp"
+# include "../iterators/merge_iterator.hpp"
+
+namespace ft
+{
+	// Map for many writers: the keys are spread by Hash over independent
+	// ft::map shards, each behind its own mutex, so the threads only wait
+	// for each other on the same shard. A view locks every shard and walks
+	// the whole map in key order
+	template <	class Key, class T,
+				class Hash = ft::hash<Key>,
+				class Compare = std::less<Key>,
+				class Alloc = std::allocator<ft::pair<const Key, T> > >
+	class sharded_map
+	{
+	private:
+		typedef				ft::map<Key, T, Compare, Alloc>					shard_map;
+	public:
+		typedef				Key												key_type;
+		typedef				T												mapped_type;
+		typedef typename	ft::pair<const key_type, mapped_type>			value_type;
+		typedef				Hash											hasher;
+		typedef				Compare											key_compare;
+		typedef				Alloc											allocator_type;
+		typedef				size_t											size_type;
+		typedef				merge_iterator<typename shard_map::const_iterator, key_compare>	const_iterator;
+
+		// The whole map in key order, the writers wait until it is destroyed
+		class view
+		{
+		public:
+			explicit view(const sharded_map& map) : map(map) {
+				for (size_type i = 0; i < map.shardCount; i++) // In order, two views cannot deadlock
+					pthread_mutex_lock(&map.shards[i].lock);
+			}
+			~view() {
+				for (size_type i = this->map.shardCount; i > 0; i--)
+					pthread_mutex_unlock(&this->map.shards[i - 1].lock);
+			}
+
+			const_iterator begin() const {
+				const_iterator it(this->map.key_comp());
+				for (size_type i = 0; i < this->map.shardCount; i++)
+					it.add(this->map.shards[i].map.begin(), this->map.shards[i].map.end());
+				return it;
+			}
+			const_iterator end() const {
+				return const_iterator(this->map.key_comp());
+			}
+			size_type size() const {
+				size_type n = 0;
+				for (size_type i = 0; i < this->map.shardCount; i++)
+					n += this->map.shards[i].map.size();
+				return n;
+			}
+
+		private:
+			const sharded_map&	map;
+
+			view(const view&);
+			view& operator=(const view&);
+		};
+
+		// Constructors & Destructor
+		explicit sharded_map(size_type count = 16,
+							const hasher& hash = hasher(),
+							const key_compare& comp = key_compare(),
+							const allocator_type& alloc = allocator_type())
+		: hash(hash), comp(comp), alloc(alloc), storage(NULL), shards(NULL), shardCount(count ? count : 1) {
+			// One more shard than needed: the first shard is moved to the next
+			// multiple of 64, the allocator only aligns for the fundamental types
+			this->storage = this->alloc.allocate(this->shardCount + 1);
+			size_t offset = reinterpret_cast<size_t>(this->storage) % 64;
+			this->shards = reinterpret_cast<shard *>(reinterpret_cast<char *>(this->storage) + (offset ? 64 - offset : 0));
+			size_type i = 0;
+			try {
+				for (; i < this->shardCount; i++)
+					new (&this->shards[i]) shard(comp, alloc);
+			} catch (...) {
+				while (i > 0)
+					this->shards[--i].~shard();
+				this->alloc.deallocate(this->storage, this->shardCount + 1);
+				throw;
+			}
+		}
+		// No other thread may still use the map
+		~sharded_map() {
+			for (size_type i = 0; i < this->shardCount; i++)
+				this->shards[i].~shard();
+			this->alloc.deallocate(this->storage, this->shardCount + 1);
+		}
+
+		/// LOOKUP, the value is copied out under the lock of its shard
+		bool find(const key_type& k, mapped_type& value) const {
+			shard& s = this->shardOf(k);
+			lock_guard guard(s);
+			typename shard_map::const_iterator it = s.map.find(k);
+			if (it == s.map.end())
+				return false;
+			value = it->second;
+			return true;
+		}
+		size_type count(const key_type& k) const {
+			shard& s = this->shardOf(k);
+			lock_guard guard(s);
+			return s.map.count(k);
+		}
+
+		/// MODIFIERS, returns whether the key was inserted
+		bool insert(const value_type& val) {
+			shard& s = this->shardOf(val.first);
+			lock_guard guard(s);
+			return s.map.insert(val).second;
+		}
+		bool insert_or_assign(const key_type& k, const mapped_type& obj) {
+			shard& s = this->shardOf(k);
+			lock_guard guard(s);
+			return s.map.insert_or_assign(k, obj).second;
+		}
+		size_type erase(const key_type& k) {
+			shard& s = this->shardOf(k);
+			lock_guard guard(s);
+			return s.map.erase(k);
+		}
+		void clear() {
+			for (size_type i = 0; i < this->shardCount; i++) {
+				lock_guard guard(this->shards[i]);
+				this->shards[i].map.clear();
+			}
+		}
+
+		// Sums the shards one after the other, exact only without writers
+		size_type size() const {
+			size_type n = 0;
+			for (size_type i = 0; i < this->shardCount; i++) {
+				lock_guard guard(this->shards[i]);
+				n += this->shards[i].map.size();
+			}
+			return n;
+		}
+		bool empty() const {
+			return this->size() == 0;
+		}
+
+		size_type shard_count() const {
+			return this->shardCount;
+		}
+		size_type shard_index(const key_type& k) const {
+			return this->hash(k) % this->shardCount;
+		}
+		// Elements of one shard, to see how Hash spreads the keys
+		size_type shard_size(size_type i) const {
+			lock_guard guard(this->shards[i]);
+			return this->shards[i].map.size();
+		}
+
+		hasher hash_function() const {
+			return this->hash;
+		}
+		key_compare key_comp() const {
+			return this->comp;
+		}
+		allocator_type get_allocator() const {
+			return allocator_type(this->alloc);
+		}
+
+	private:
+		// Whole cache lines per shard, and the shards start on a line: no line
+		// holds the lock or the map of two shards
+		struct shard_data {
+			shard_data(const key_compare& comp, const allocator_type& alloc) : map(comp, alloc) {
+				pthread_mutex_init(&this->lock, NULL);
+			}
+			~shard_data() {
+				pthread_mutex_destroy(&this->lock);
+			}
+			shard_map		map;
+			pthread_mutex_t	lock;
+		};
+		struct shard : public shard_data {
+			shard(const key_compare& comp, const allocator_type& alloc) : shard_data(comp, alloc) {}
+			char	pad[64 - sizeof(shard_data) % 64];
+		};
+		struct lock_guard {
+			lock_guard(shard& s) : s(s) {
+				pthread_mutex_lock(&this->s.lock);
+			}
+			~lock_guard() {
+				pthread_mutex_unlock(&this->s.lock);
+			}
+			shard&	s;
+		};
+		typedef typename Alloc::template rebind<shard>::other	shard_allocator;
+
+		hasher			hash;
+		key_compare		comp;
+		shard_allocator	alloc;
+		shard			*storage;	// As allocated
+		shard			*shards;	// The first 64 bytes aligned shard of storage
+		size_type		shardCount;
+
+		sharded_map(const sharded_map&);
+		sharded_map& operator=(const sharded_map&);
+
+		shard& shardOf(const key_type& k) const {
+			return this->shards[this->hash(k) % this->shardCount];
+		}
+	};
+}
+
+#endif // SHARDED_MAP_HPP
@@ -5,8 +5,50 @@
 
 namespace ft
 {
+	// Fallback of shrink_to_fit for the containers without one, ft::vector and
+	// ft::deque overload it next to their non member swap
+	template <class Container>
+		void shrink_to_fit(Container& c) {
+			Container(c).swap(c);
+		}
+
+	// Trimming policies of stack, told after each push and pop: no_trim keeps
+	// the capacity of the container, as std::stack does
+	struct no_trim {
+		template <class Container>
+			void pushed(const Container&) {}
+		template <class Container>
+			void popped(Container&) {}
+	};
+
+	// Remembers the highest size reached, and shrinks the container when a pop
+	// brings the size to 1/Ratio of it: the memory of a burst is given back,
+	// in O(1) amortized per pop, without trimming stacks smaller than MinSize
+	template <std::size_t MinSize = 1024, std::size_t Ratio = 4>
+		class high_water_trim {
+			public:
+				high_water_trim() : mark(0) {}
+
+				template <class Container>
+					void pushed(const Container& c) {
+						if (c.size() > this->mark)
+							this->mark = c.size();
+					}
+				template <class Container>
+					void popped(Container& c) {
+						if (this->mark >= MinSize && c.size() * Ratio <= this->mark) {
+							shrink_to_fit(c);
+							this->mark = c.size();
+						}
+					}
+
+			private:
+				std::size_t	mark;
+		};
+
 	template <	class T, 						// Type of element stored
-				class Container = ft::vector<T> >	// Type of underlying container to use to store the elements
+				class Container = ft::vector<T>,	// Type of underlying container to use to store the elements
+				class TrimPolicy = ft::no_trim >	// When the capacity left by pop is released
 		class stack
 		{
 			public :
@@ -21,13 +63,10 @@ namespace ft
 
 				stack& operator=(const stack& other) {
 					this->c = other.c;
+					this->policy = other.policy;
 					return *this;
 				}
 
-				~stack() {
-					this->c.clear();
-				}
-
 				// Element access
 
 				value_type& top() { 
@@ -53,69 +92,93 @@ namespace ft
 				// Modifiers
 				void push(const value_type& val) {
 					this->c.push_back(val);
+					this->policy.pushed(this->c);
+				}
+
+				// The element is constructed in place, by emplace_back of the container
+				void emplace() {
+					this->c.emplace_back();
+					this->policy.pushed(this->c);
 				}
+				template <class A1>
+					void emplace(const A1& a1) {
+						this->c.emplace_back(a1);
+						this->policy.pushed(this->c);
+					}
+				template <class A1, class A2>
+					void emplace(const A1& a1, const A2& a2) {
+						this->c.emplace_back(a1, a2);
+						this->policy.pushed(this->c);
+					}
+				template <class A1, class A2, class A3>
+					void emplace(const A1& a1, const A2& a2, const A3& a3) {
+						this->c.emplace_back(a1, a2, a3);
+						this->policy.pushed(this->c);
+					}
 
 				void pop() {
 					this->c.pop_back();
+					this->policy.popped(this->c);
 				}
 
-				template <typename U, typename Ctnr>
-		  			friend bool operator==(const stack<U,Ctnr>& lhs, const stack<U,Ctnr>& rhs);
-				template <typename U, typename Ctnr>
-		  			friend bool operator!=(const stack<U,Ctnr>& lhs, const stack<U,Ctnr>& rhs);
-				template <typename U, typename Ctnr>
-		  			friend bool operator<(const stack<U,Ctnr>& lhs, const stack<U,Ctnr>& rhs);
-				template <typename U, typename Ctnr>
-		  			friend bool operator>(const stack<U,Ctnr>& lhs, const stack<U,Ctnr>& rhs);
-				template <typename U, typename Ctnr>
-		  			friend bool operator<=(const stack<U,Ctnr>& lhs, const stack<U,Ctnr>& rhs);
-				template <typename U, typename Ctnr>
-		  			friend bool operator>=(const stack<U,Ctnr>& lhs, const stack<U,Ctnr>& rhs);
+				template <typename U, typename Ctnr, typename P>
+		  			friend bool operator==(const stack<U,Ctnr,P>& lhs, const stack<U,Ctnr,P>& rhs);
+				template <typename U, typename Ctnr, typename P>
+		  			friend bool operator!=(const stack<U,Ctnr,P>& lhs, const stack<U,Ctnr,P>& rhs);
+				template <typename U, typename Ctnr, typename P>
+		  			friend bool operator<(const stack<U,Ctnr,P>& lhs, const stack<U,Ctnr,P>& rhs);
+				template <typename U, typename Ctnr, typename P>
+		  			friend bool operator>(const stack<U,Ctnr,P>& lhs, const stack<U,Ctnr,P>& rhs);
+				template <typename U, typename Ctnr, typename P>
+		  			friend bool operator<=(const stack<U,Ctnr,P>& lhs, const stack<U,Ctnr,P>& rhs);
+				template <typename U, typename Ctnr, typename P>
+		  			friend bool operator>=(const stack<U,Ctnr,P>& lhs, const stack<U,Ctnr,P>& rhs);
 			
 
 			protected:
 				container_type 		c;
+				TrimPolicy			policy;
 				
 		};
 
 		// Non member relational operators
-		template <typename U, typename Ctnr>
-		  bool operator==(const stack<U,Ctnr>& lhs, const stack<U,Ctnr>& rhs) {
+		template <typename U, typename Ctnr, typename P>
+		  bool operator==(const stack<U,Ctnr,P>& lhs, const stack<U,Ctnr,P>& rhs) {
 			if (lhs.c == rhs.c)
 				return true;
 			return false;
 		  }
 
-		template <typename U, typename Ctnr>
-			bool operator!=(const stack<U,Ctnr>& lhs, const stack<U,Ctnr>& rhs) {
+		template <typename U, typename Ctnr, typename P>
+			bool operator!=(const stack<U,Ctnr,P>& lhs, const stack<U,Ctnr,P>& rhs) {
 				if (lhs.c != rhs.c)
 					return true;
 				return false;
 			}
 
-		template <typename U, typename Ctnr>
-			bool operator<(const stack<U,Ctnr>& lhs, const stack<U,Ctnr>& rhs) {
+		template <typename U, typename Ctnr, typename P>
+			bool operator<(const stack<U,Ctnr,P>& lhs, const stack<U,Ctnr,P>& rhs) {
 				if (lhs.c < rhs.c)
 					return true;
 				return false;
 			}
 
-		template <typename U, typename Ctnr>
-			bool operator<=(const stack<U,Ctnr>& lhs, const stack<U,Ctnr>& rhs) {
+		template <typename U, typename Ctnr, typename P>
+			bool operator<=(const stack<U,Ctnr,P>& lhs, const stack<U,Ctnr,P>& rhs) {
 				if (lhs.c <= rhs.c)
 					return true;
 				return false;
 			}
 
-		template <typename U, typename Ctnr>
-			bool operator>(const stack<U,Ctnr>& lhs, const stack<U,Ctnr>& rhs) {
+		template <typename U, typename Ctnr, typename P>
+			bool operator>(const stack<U,Ctnr,P>& lhs, const stack<U,Ctnr,P>& rhs) {
 				if (lhs.c > rhs.c)
 					return true;
 				return false;
 			}
 
-		template <typename U, typename Ctnr>
-			bool operator>=(const stack<U,Ctnr>& lhs, const stack<U,Ctnr>& rhs) {
+		template <typename U, typename Ctnr, typename P>
+			bool operator>=(const stack<U,Ctnr,P>& lhs, const stack<U,Ctnr,P>& rhs) {
 				if (lhs.c >= rhs.c)
 					return true;
 				return false;
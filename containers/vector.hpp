@@ -6,12 +6,15 @@
 # include <sstream>
 # include <stdexcept>
 # include <typeinfo>
+# include <algorithm>
 # include "../iterators/vector_iterator.hpp"
 # include "../iterators/reverse_iterator.hpp"
 # include "../utils/iterator_traits.hpp"
 # include "../utils/lexicographical_compare.hpp"
+# include "../utils/equal.hpp"
 # include "../utils/enable_if.hpp"
 # include "../utils/is_integral.hpp"
+# include "../utils/emplace_args.hpp"
 
 namespace ft
 {
@@ -51,7 +54,7 @@ namespace ft
 					this->assign(first, last);
 				}
 			
-			vector (const vector &x) : arr(NULL), _size(0), _capacity(0), old_resize(0) {	// copy constructor
+			vector (const vector &x) : arr(NULL), _alloc(x._alloc), _size(0), _capacity(0), old_resize(0) {	// copy constructor, with the allocator of x
 				*this = x;
 			}
 						
@@ -64,7 +67,7 @@ namespace ft
 				}
 			}
 			
-			// Operators=
+			// Operators=, the elements are copied with the allocator of this vector
 			vector& operator=(const vector& x) {
 				if (this != &x)
 					this->assign(x.begin(), x.end());
@@ -122,7 +125,7 @@ namespace ft
 				else {
 					if (n > this->_capacity) {
 						size_type new_capacity;
-						if (n > this->old_resize == 0 || n > this->old_resize * 2)
+						if (n <= this->old_resize || n > this->old_resize * 2)
 							new_capacity = n;
 						else
 							new_capacity = this->old_resize * 2; // add a capacity de size * 2 of the previous size
@@ -145,6 +148,18 @@ namespace ft
 				return false;
 			}
 
+			void shrink_to_fit() {	// Release the capacity that is not used, the elements are reallocated
+				if (this->_capacity == this->_size)
+					return ;
+				if (this->_size == 0) {
+					this->_alloc.deallocate(this->arr, this->_capacity);
+					this->arr = NULL;
+					this->_capacity = 0;
+					return ;
+				}
+				this->reallocate(this->_size);
+			}
+
 			void reserve(size_type n) { // Request a change in capacity, for the container be at leat enough to contain n elements
 				if (n > this->max_size())
 					throw(std::length_error("vector::reserve"));
@@ -206,38 +221,7 @@ namespace ft
 			template <class InputIterator> // Range // New contents constructed in the range between first and last
 				void assign(InputIterator first, InputIterator last, 
 					typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)  {
-					size_type new_size = 0;
-					size_type i = 0;
-					InputIterator it = first;
-
-					while (it != last) { // Recover the size of new contents to add
-						new_size++;
-						it++;
-					}
-					reserve(new_size);
-
-					if (new_size < this->_size) { // Check if allocation is needed
-						while (i < new_size) {
-							this->_alloc.destroy(this->arr + i);
-							this->_alloc.construct(this->arr + i, *first++);
-							i++;
-						}
-						while (i < this->_size) {
-							this->_alloc.destroy(this->arr + i);
-							i++;
-						}
-					} else {
-						while (i < this->_size) {
-							this->_alloc.destroy(this->arr + i);
-							this->_alloc.construct(this->arr + i, *first++);
-							i++;
-						}
-						while (i < new_size) {
-							this->_alloc.construct(this->arr + i, *first++);
-							i++;
-						}
-					}
-					this->_size = new_size; // Update the size with the new one
+					this->assignRange(ft::unwrap_iterator(first), ft::unwrap_iterator(last));
 				}
 
 			void assign(size_type n, const value_type& val) { // Fill // new contents are n elements, each initialized to a copy of val
@@ -277,39 +261,67 @@ namespace ft
 								/*  push/pop_back  */
 
 			void push_back(const value_type& val) {		// Add element to the end of the vector
-				if (this->_size + 1 > this->_capacity) { // If size > at current capacity
-					size_type new_capacity = this->_capacity; // Stock the current capacity in new_capacity
-					if (new_capacity == 0) // If the capacity = 0, we can t double 0 so we initialized new_capacity = 1
-						new_capacity = 1;
-					else
-						new_capacity *= 2; // Need more capacity so reallocate the double of current capacity
-					this->reallocate(new_capacity);
-				}
-				this->_alloc.construct(this->arr + this->_size, val);
-				this->_size++; // Size increases as we add an element to the vector
+				this->emplaceBack(ft::emplace_args1<value_type>(val));
 			}
 
-			void pop_back() { 	// Delete the last element in the vector
-				this->erase(this->end() - 1);
+			void pop_back() { 	// Delete the last element in the vector, the capacity is kept
+				this->_size--;
+				this->_alloc.destroy(this->arr + this->_size);
 			}
 
+								/*   Emplace   */
+			// The element is constructed in place from up to 3 arguments, so no
+			// temporary value_type is copied into the vector
+			void emplace_back() {
+				this->emplaceBack(ft::emplace_args0());
+			}
+			template <class A1>
+				void emplace_back(const A1& a1) {
+					this->emplaceBack(ft::emplace_args1<A1>(a1));
+				}
+			template <class A1, class A2>
+				void emplace_back(const A1& a1, const A2& a2) {
+					this->emplaceBack(ft::emplace_args2<A1, A2>(a1, a2));
+				}
+			template <class A1, class A2, class A3>
+				void emplace_back(const A1& a1, const A2& a2, const A3& a3) {
+					this->emplaceBack(ft::emplace_args3<A1, A2, A3>(a1, a2, a3));
+				}
+
+			iterator emplace(iterator position) {
+				return this->emplaceAt(position - this->begin(), ft::emplace_args0());
+			}
+			template <class A1>
+				iterator emplace(iterator position, const A1& a1) {
+					return this->emplaceAt(position - this->begin(), ft::emplace_args1<A1>(a1));
+				}
+			template <class A1, class A2>
+				iterator emplace(iterator position, const A1& a1, const A2& a2) {
+					return this->emplaceAt(position - this->begin(), ft::emplace_args2<A1, A2>(a1, a2));
+				}
+			template <class A1, class A2, class A3>
+				iterator emplace(iterator position, const A1& a1, const A2& a2, const A3& a3) {
+					return this->emplaceAt(position - this->begin(), ft::emplace_args3<A1, A2, A3>(a1, a2, a3));
+				}
+
 								/*   Insert   */
 			// Vector is extended by inserting new elements before the element at the specified position
 			iterator insert(iterator position, const value_type& val) { // Single element
 				size_type id = position - this->begin();	// calculate the distance between the adress of begin() and the adress of position (adresse - adresse = int distance)
 				if (this->_size + 1 > this->_capacity)		// Need to reallocate cause size + 1 > at current capacity
 					this->reallocate(this->_size + 1);
-				if (this->empty()) {	// If it's empty, just need to construct the new element at the begin() and we can t use an iterator in an empty array
-					this->_alloc.construct(this->arr, val);
-					this->_size++;
-					return this->begin();
+				pointer pos = this->arr + id;
+				pointer end = this->arr + this->_size;
+				if (pos == end)		// Nothing to offset, the new element is constructed at the end
+					this->_alloc.construct(end, val);
+				else {				// Offset the elements from position to the end to the right, the last one is constructed in the uninitialized space
+					this->_alloc.construct(end, *(end - 1));
+					for (pointer p = end - 1; p != pos; p--)
+						*p = *(p - 1);
+					*pos = val;
 				}
-				for (size_type i = this->_size; i > id; i--) // Offset(decaler) the element of the vector from the end to before the id to let spaces for new elements // Offset the end to the right to insert the element at position 
-					this->arr[i] = this->arr[i - 1];
-				this->_alloc.construct(this->arr + id, val);
-				this->_size++;								 // Increased the size by + 1 for the new element
-				return this->begin() + id; // return begin + position - begin = position But as we have shifted the elements the position address 
-								// is not valid anymore so we use id to get our new position
+				this->_size++;		// Increased the size by + 1 for the new element
+				return iterator(pos);	// pos is computed from id, position is not valid anymore after a reallocation
 			}
 
 			void insert(iterator position, size_type n, const value_type& val) { // Fill
@@ -349,36 +361,7 @@ namespace ft
 			template<class InputIterator>
 				void insert(iterator position, InputIterator first, InputIterator last,
 					typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) { // Range
-					size_type id = position - this->begin();
-					size_type new_size = 0;
-					for (InputIterator it = first; it != last; it ++)
-						new_size++;
-					if (this->_size + new_size > this->_capacity)
-						this->reallocate(this->_size * 2 + new_size);
-					if (this->empty()) {
-						size_type i = 0;
-						for (InputIterator it = first; it != last; it++, i++)
-							this->_alloc.construct(this->arr + i, *it);
-						this->_size += new_size;
-					}
-					else {
-						for (size_type i = this->_size + new_size - 1; i >= id + new_size; i--)
-							if (i >= this->_size)
-								this->_alloc.construct(this->arr + i, this->arr[i - new_size]);
-							else
-								this->arr[i] = this->arr[i - new_size];
-						size_type i = 0;
-						for (InputIterator it = first; it != last; it ++, i++) {
-							if (id + i < this->_size) {
-								this->_alloc.destroy(this->arr + id + i);
-								this->_alloc.construct(this->arr + id + i, *it);
-							}
-							else {
-								this->_alloc.construct(this->arr + id + i, *it);
-							}
-						}
-						this->_size += new_size;
-					}
+					this->insertRange(position - this->begin(), ft::unwrap_iterator(first), ft::unwrap_iterator(last));
 				}
 						/*   Erase   */
 
@@ -389,51 +372,21 @@ namespace ft
 			iterator erase(iterator first, iterator last) {		// Remove a range of elements from first to last
 				if (first == this->end() || first == last)
 					return first;
-
-				size_type begin = 0;
-				size_type first_to_last = 0;
-				size_type last_to_end = 0;
-				size_type i = 0;
-
-				iterator it = this->begin();
-
-				//count begin
-				while (it != first) {
-					begin++;
-					it++;
-				}
-				it = first;
-				while (it != last) {
-					first_to_last++;
-					it ++;
-				}
-
-				//count last to end
-				it = last;
-				while (it != this->end()) {
-					last_to_end++;
-					it++;
-				}
-				//Allows not to lose the first ones which would not be to remove
-				while (i < last_to_end)
-				{
-					this->_alloc.destroy(&this->arr[begin + i]);
-					this->_alloc.construct(&this->arr[begin + i], this->arr[begin + i + first_to_last]);
-					i++;
-				}
-				// Destroy tout entre first et last
-				i = 0;
-				while (i < first_to_last) {
-					this->_alloc.destroy(&this->arr[begin + last_to_end + i]);
-					i++;
-				}
-				this->_size -= first_to_last;
+				pointer dst = first.base();
+				pointer src = last.base();
+				pointer end = this->arr + this->_size;
+				while (src != end)		// Allows not to lose the ones after last
+					*dst++ = *src++;
+				while (dst != end)		// Destroy the moved-from tail
+					this->_alloc.destroy(dst++);
+				this->_size -= last - first;
 				return first;
 			}
 
 						/*  Swap/Clear  */
 
-			void swap(vector& x) {		// Exchange the content of the container by the content of x
+			void swap(vector& x) {		// Exchange the content of the container by the content of x, and their allocators
+				std::swap(this->_alloc, x._alloc);
 				pointer tmp = this->arr;
 				this->arr = x.arr;
 				x.arr = tmp;
@@ -464,6 +417,117 @@ namespace ft
 			size_type		_capacity; // allocated size of the vector
 			size_type		old_resize;
 
+			// Range algorithms, on unwrapped iterators (raw pointers for vector_iterator)
+			template <class InputIterator>
+				void assignRange(InputIterator first, InputIterator last) {
+					size_type new_size = ft::distance(first, last);
+					size_type i = 0;
+					reserve(new_size);
+
+					if (new_size < this->_size) { // Check if allocation is needed
+						while (i < new_size) {
+							this->_alloc.destroy(this->arr + i);
+							this->_alloc.construct(this->arr + i, *first++);
+							i++;
+						}
+						while (i < this->_size) {
+							this->_alloc.destroy(this->arr + i);
+							i++;
+						}
+					} else {
+						while (i < this->_size) {
+							this->_alloc.destroy(this->arr + i);
+							this->_alloc.construct(this->arr + i, *first++);
+							i++;
+						}
+						while (i < new_size) {
+							this->_alloc.construct(this->arr + i, *first++);
+							i++;
+						}
+					}
+					this->_size = new_size; // Update the size with the new one
+				}
+
+			template <class InputIterator>
+				void insertRange(size_type id, InputIterator first, InputIterator last) {
+					size_type new_size = ft::distance(first, last);
+					if (this->_size + new_size > this->_capacity)
+						this->reallocate(this->_size * 2 + new_size);
+					if (this->empty()) {
+						size_type i = 0;
+						for (InputIterator it = first; it != last; it++, i++)
+							this->_alloc.construct(this->arr + i, *it);
+						this->_size += new_size;
+					}
+					else {
+						// Offset the elements after id to the right, those going past the end are constructed
+						size_type split = std::max(this->_size, id + new_size);
+						for (size_type i = this->_size + new_size; i-- > split; )
+							this->_alloc.construct(this->arr + i, this->arr[i - new_size]);
+						for (size_type i = split; i-- > id + new_size; )
+							this->arr[i] = this->arr[i - new_size];
+						size_type i = 0;
+						for (InputIterator it = first; it != last; it ++, i++) {
+							if (id + i < this->_size) {
+								this->_alloc.destroy(this->arr + id + i);
+								this->_alloc.construct(this->arr + id + i, *it);
+							}
+							else {
+								this->_alloc.construct(this->arr + id + i, *it);
+							}
+						}
+						this->_size += new_size;
+					}
+				}
+
+			// The new element is constructed before the old storage is released:
+			// the arguments may refer to an element of the vector
+			template <class Args>
+				void emplaceBack(const Args& args) {
+					if (this->_size < this->_capacity) {
+						args(this->arr + this->_size);
+						this->_size++;
+						return ;
+					}
+					size_type new_capacity = (this->_capacity == 0) ? 1 : this->_capacity * 2;
+					pointer tmp = this->_alloc.allocate(new_capacity);
+					try {
+						args(tmp + this->_size);
+					} catch (...) {
+						this->_alloc.deallocate(tmp, new_capacity);
+						throw;
+					}
+					this->relocate(tmp, new_capacity);
+					this->_size++;
+				}
+
+			// Only the end is constructed in place, in the middle the element is
+			// built aside then inserted, as the shift assigns over it
+			template <class Args>
+				iterator emplaceAt(size_type id, const Args& args) {
+					if (id == this->_size) {
+						this->emplaceBack(args);
+						return iterator(this->arr + id);
+					}
+					pointer tmp = this->_alloc.allocate(1);
+					try {
+						args(tmp);
+					} catch (...) {
+						this->_alloc.deallocate(tmp, 1);
+						throw;
+					}
+					try {
+						this->insert(this->begin() + id, *tmp);
+					} catch (...) {
+						this->_alloc.destroy(tmp);
+						this->_alloc.deallocate(tmp, 1);
+						throw;
+					}
+					this->_alloc.destroy(tmp);
+					this->_alloc.deallocate(tmp, 1);
+					return iterator(this->arr + id);
+				}
+
 			// Get the error message for out_of_range exception
 			std::string out_of_range_what(size_type n) const {
 				std::stringstream ss;
@@ -502,13 +566,17 @@ namespace ft
 			}
 
 			void reallocate(size_type new_capacity) {
-				pointer tmp = this->_alloc.allocate(new_capacity);
+				this->relocate(this->_alloc.allocate(new_capacity), new_capacity);
+			}
+
+			void relocate(pointer tmp, size_type new_capacity) {	// Moves the elements to tmp, allocated with new_capacity
 				for (size_type i = 0; i < this->_size; i++)
 				{
 					this->_alloc.construct(tmp + i, this->arr[i]);
 					this->_alloc.destroy(&this->arr[i]);
 				}
-				this->_alloc.deallocate(this->arr, this->_capacity);
+				if (this->arr)		// Only the pointers of allocate() can be given back to the allocator
+					this->_alloc.deallocate(this->arr, this->_capacity);
 				this->arr = tmp;
 				this->_capacity = new_capacity;
 			}
@@ -520,10 +588,7 @@ template <class T, class Alloc>
 	bool operator==(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
 		if (lhs.size() != rhs.size())
 			return false;
-		for (typename vector<T>::size_type i = 0; i < lhs.size(); i++)
-			if (lhs[i] != rhs[i])
-				return false;
-		return true;
+		return ft::equal(lhs.data(), lhs.data() + lhs.size(), rhs.data());	// memcmp for integral types
 	}
 
 template <class T, class Alloc>
@@ -533,7 +598,8 @@ template <class T, class Alloc>
 
 template <class T, class Alloc>
 	bool operator<(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
-		return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		return ft::lexicographical_compare(lhs.data(), lhs.data() + lhs.size(),
+										   rhs.data(), rhs.data() + rhs.size());
 	}
 
 template <class T, class Alloc>
@@ -556,6 +622,12 @@ template <class T, class Alloc>
 	void swap(vector<T, Alloc>& x, vector<T, Alloc>& y) {
 		x.swap(y);
 	}
+
+	// See stack.hpp
+template <class T, class Alloc>
+	void shrink_to_fit(vector<T, Alloc>& x) {
+		x.shrink_to_fit();
+	}
 }
 
 #endif // VECTOR_HPP
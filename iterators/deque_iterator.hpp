@@ -0,0 +1,169 @@
+#ifndef DEQUE_ITERATOR_HPP
+# define DEQUE_ITERATOR_HPP
+
+# include <iostream>
+# include <iterator>
+
+namespace ft
+{
+	// Number of elements of a deque block: 4KB blocks for the small types,
+	// 16 elements for the big ones (so a block never holds a single element)
+	template <class T>
+	struct deque_block {
+		static const std::ptrdiff_t size = (sizeof(T) <= 256) ? 4096 / sizeof(T) : 16;
+	};
+
+	template <class T>
+	class deque_iterator : public std::iterator<std::random_access_iterator_tag, T>
+	{
+	private:
+		typedef typename std::iterator<std::random_access_iterator_tag, T> iterator;
+	public:
+		typedef typename iterator::value_type			value_type;
+		typedef typename iterator::difference_type		difference_type;
+		typedef typename iterator::pointer				pointer;
+		typedef typename iterator::reference			reference;
+		typedef typename iterator::iterator_category	iterator_category;
+		typedef pointer*								map_pointer;
+
+		// Canonical form, the copy is the implicit (trivial) one
+		deque_iterator() : cur(NULL), first(NULL), last(NULL), node(NULL) {}
+		deque_iterator(pointer cur, map_pointer node)
+		: cur(cur), first(*node), last(*node + deque_block<T>::size), node(node) {}
+		template <typename U>
+		operator deque_iterator<const U>() const {
+			return deque_iterator<const U>(this->cur, (const U**)this->node);
+		}
+
+		// Dereferencing
+		reference operator*() const {
+			return *this->cur;
+		}
+		pointer operator->() const {
+			return this->cur;
+		}
+		reference operator[](difference_type n) const {
+			return *(*this + n);
+		}
+
+		// Increment & Decrement, the iterator jumps to the next block at its end
+		deque_iterator &operator++() { // Pre-incrementation
+			if (++this->cur == this->last) {
+				this->setNode(this->node + 1);
+				this->cur = this->first;
+			}
+			return *this;
+		}
+		deque_iterator	operator++(int) { // Post-incrementation
+			deque_iterator tmp(*this);
+			this->operator++();
+			return tmp;
+		}
+		deque_iterator &operator--() { // Pre-decrementation
+			if (this->cur == this->first) {
+				this->setNode(this->node - 1);
+				this->cur = this->last;
+			}
+			this->cur--;
+			return *this;
+		}
+		deque_iterator	operator--(int) { // Post-decrementation
+			deque_iterator tmp(*this);
+			this->operator--();
+			return tmp;
+		}
+
+		// Arithmetic operations
+		deque_iterator &operator+=(difference_type n) {
+			difference_type offset = n + (this->cur - this->first);
+			if (offset >= 0 && offset < deque_block<T>::size)
+				this->cur += n;
+			else {
+				difference_type nodeOffset = (offset > 0) ? offset / deque_block<T>::size
+					: -((-offset - 1) / deque_block<T>::size) - 1;
+				this->setNode(this->node + nodeOffset);
+				this->cur = this->first + (offset - nodeOffset * deque_block<T>::size);
+			}
+			return *this;
+		}
+		deque_iterator &operator-=(difference_type n) {
+			return *this += -n;
+		}
+		deque_iterator operator+(difference_type n) const {
+			deque_iterator tmp(*this);
+			return tmp += n;
+		}
+		deque_iterator operator-(difference_type n) const {
+			deque_iterator tmp(*this);
+			return tmp -= n;
+		}
+
+		// For the internal operations of deque
+		pointer getCur() const {
+			return this->cur;
+		}
+		map_pointer getNode() const {
+			return this->node;
+		}
+		void setNode(map_pointer node) {
+			this->node = node;
+			this->first = *node;
+			this->last = this->first + deque_block<T>::size;
+		}
+		void setCur(pointer cur) {
+			this->cur = cur;
+		}
+		pointer getFirst() const {
+			return this->first;
+		}
+		pointer getLast() const {
+			return this->last;
+		}
+
+	private:
+		pointer		cur;	// Current element
+		pointer		first;	// Bounds of the block of cur
+		pointer		last;
+		map_pointer	node;	// Block of cur in the map of the deque
+	};
+
+	template <class T>
+	deque_iterator<T> operator+(typename deque_iterator<T>::difference_type n, const deque_iterator<T>& it) {
+		return it + n;
+	}
+
+	template <typename T, typename U>
+	typename deque_iterator<T>::difference_type operator-(const deque_iterator<T>& lhs, const deque_iterator<U>& rhs) {
+		return deque_block<T>::size * (lhs.getNode() - (T**)rhs.getNode() - 1)
+			+ (lhs.getCur() - lhs.getFirst()) + (rhs.getLast() - rhs.getCur());
+	}
+
+	template <typename T, typename U>
+	bool operator==(const deque_iterator<T>& lhs, const deque_iterator<U>& rhs) {
+		return lhs.getCur() == rhs.getCur();
+	}
+	template <typename T, typename U>
+	bool operator!=(const deque_iterator<T>& lhs, const deque_iterator<U>& rhs) {
+		return !(lhs == rhs);
+	}
+	template <typename T, typename U>
+	bool operator<(const deque_iterator<T>& lhs, const deque_iterator<U>& rhs) {
+		if (lhs.getNode() == (T**)rhs.getNode())
+			return lhs.getCur() < rhs.getCur();
+		return lhs.getNode() < (T**)rhs.getNode();
+	}
+	template <typename T, typename U>
+	bool operator>(const deque_iterator<T>& lhs, const deque_iterator<U>& rhs) {
+		return rhs < lhs;
+	}
+	template <typename T, typename U>
+	bool operator<=(const deque_iterator<T>& lhs, const deque_iterator<U>& rhs) {
+		return !(rhs < lhs);
+	}
+	template <typename T, typename U>
+	bool operator>=(const deque_iterator<T>& lhs, const deque_iterator<U>& rhs) {
+		return !(lhs < rhs);
+	}
+}
+
+#endif // DEQUE_ITERATOR_HPP
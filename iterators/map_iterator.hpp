@@ -58,18 +58,16 @@ namespace ft
 		friend bool operator!=(const map_iterator<U, Node2>& lhs,
 								const map_iterator<V, Node3>& rhs);
 
-		// Dereferencing
-		value_type operator*() const {
+		// Dereferencing, the pair is never copied (reference is const for a const_iterator)
+		reference operator*() const {
 			return this->node->pair;
 		}
-		value_type *operator->() {
+		pointer operator->() const {
 			return &this->node->pair;
 		}
-		value_type *operator->() const {
-			return &this->node->pair;
-		}
-		value_type &operator*() { // Dereferencing as an lvalue
-			return this->node->pair;
+
+		node_ptr getNode() const { // For the internal operations of map
+			return this->node;
 		}
 
 		// Increment & Decrement
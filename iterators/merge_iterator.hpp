@@ -0,0 +1,114 @@
+#ifndef MERGE_ITERATOR_HPP
+# define MERGE_ITERATOR_HPP
+
+# include <iterator>
+# include "../containers/vector.hpp"
+
+namespace ft
+{
+	// Forward iterator over the union of sorted ranges, in key order: the
+	// ranges hold distinct keys (the shards of a map). A min-heap of the
+	// ranges on their first key gives each step in O(log ranges)
+	template <class Iterator, class Compare>
+	class merge_iterator : public std::iterator<std::forward_iterator_tag,
+											typename Iterator::value_type>
+	{
+	private:
+		typedef typename std::iterator<std::forward_iterator_tag,
+									typename Iterator::value_type>	iterator;
+	public:
+		typedef typename iterator::value_type			value_type;
+		typedef typename iterator::difference_type		difference_type;
+		typedef typename Iterator::pointer				pointer;
+		typedef typename Iterator::reference			reference;
+		typedef typename iterator::iterator_category	iterator_category;
+
+		// Canonical form, the default one is the end
+		merge_iterator() {}
+		explicit merge_iterator(const Compare& comp) : comp(comp) {}
+		merge_iterator(const merge_iterator &it) {
+			*this = it;
+		}
+		merge_iterator	&operator=(const merge_iterator& it) {
+			this->heap = it.heap;
+			this->comp = it.comp;
+			return *this;
+		}
+
+		// The ranges are added before the first increment, empty ones are skipped
+		void add(Iterator first, Iterator last) {
+			if (first == last)
+				return ;
+			this->heap.push_back(range(first, last));
+			for (size_t i = this->heap.size() - 1; i > 0 && this->less(i, (i - 1) / 2); i = (i - 1) / 2)
+				this->swap(i, (i - 1) / 2);
+		}
+
+		/// OPERATORS
+		// Equality Comparisons, two ends are equal
+		bool operator==(const merge_iterator& rhs) const {
+			if (this->heap.empty() || rhs.heap.empty())
+				return this->heap.empty() && rhs.heap.empty();
+			return this->heap[0].first == rhs.heap[0].first;
+		}
+		bool operator!=(const merge_iterator& rhs) const {
+			return !(*this == rhs);
+		}
+
+		// Dereferencing
+		reference operator*() const {
+			return *this->heap[0].first;
+		}
+		pointer operator->() const {
+			return &*this->heap[0].first;
+		}
+
+		// Increment: the smallest range moves on and sinks back in the heap
+		merge_iterator &operator++() { // Pre-incrementation
+			if (++this->heap[0].first == this->heap[0].last) {
+				this->heap[0] = this->heap.back();
+				this->heap.pop_back();
+			}
+			size_t i = 0;
+			for (;;) {
+				size_t smallest = i;
+				if (2 * i + 1 < this->heap.size() && this->less(2 * i + 1, smallest))
+					smallest = 2 * i + 1;
+				if (2 * i + 2 < this->heap.size() && this->less(2 * i + 2, smallest))
+					smallest = 2 * i + 2;
+				if (smallest == i)
+					break;
+				this->swap(i, smallest);
+				i = smallest;
+			}
+			return *this;
+		}
+		merge_iterator	operator++(int) { // Post-incrementation
+			merge_iterator tmp(*this);
+			this->operator++();
+			return tmp;
+		}
+
+	private:
+		struct range {
+			range() {}
+			range(Iterator first, Iterator last) : first(first), last(last) {}
+			Iterator	first;
+			Iterator	last;
+		};
+
+		ft::vector<range>	heap;
+		Compare				comp;
+
+		bool less(size_t lhs, size_t rhs) const {
+			return this->comp(this->heap[lhs].first->first, this->heap[rhs].first->first);
+		}
+		void swap(size_t lhs, size_t rhs) {
+			range tmp = this->heap[lhs];
+			this->heap[lhs] = this->heap[rhs];
+			this->heap[rhs] = tmp;
+		}
+	};
+}
+
+#endif // MERGE_ITERATOR_HPP
@@ -0,0 +1,98 @@
+#ifndef PERSISTENT_ITERATOR_HPP
+# define PERSISTENT_ITERATOR_HPP
+
+# include <iterator>
+# include "../utils/persistent_avl.hpp"
+
+namespace ft
+{
+	// Forward iterator over one version of a persistent tree: the nodes have
+	// no parent, the path from the root is kept in the iterator. An AVL tree
+	// of 2^64 nodes is less than 93 high
+	template <class T, typename Node>
+	class persistent_iterator : public std::iterator<std::forward_iterator_tag, T>
+	{
+	private:
+		typedef typename std::iterator<std::forward_iterator_tag, T>	iterator;
+		typedef const Node*												node_ptr;
+		static const int												max_depth = 96;
+	public:
+		typedef typename iterator::value_type			value_type;
+		typedef typename iterator::difference_type		difference_type;
+		typedef typename iterator::pointer				pointer;
+		typedef typename iterator::reference			reference;
+		typedef typename iterator::iterator_category	iterator_category;
+
+		// Canonical form, the default one is the end of every tree
+		persistent_iterator() : depth(0) {}
+		persistent_iterator(const persistent_iterator &it) {
+			*this = it;
+		}
+		persistent_iterator	&operator=(const persistent_iterator& it) {
+			this->depth = it.depth;
+			for (int i = 0; i < it.depth; i++)
+				this->path[i] = it.path[i];
+			return *this;
+		}
+
+		// The smallest node of root
+		explicit persistent_iterator(node_ptr root) : depth(0) {
+			this->pushLeft(root);
+		}
+		// The first node not less than key, or greater than key with upper
+		template <class K, class Compare>
+		persistent_iterator(node_ptr root, const K& key, const Compare& comp, bool upper = false) : depth(0) {
+			while (root) {
+				if (upper ? !comp(key, root->pair.first) : comp(root->pair.first, key))
+					root = root->right;
+				else {
+					this->path[this->depth++] = root;
+					root = root->left;
+				}
+			}
+		}
+
+		/// OPERATORS
+		// Equality Comparisons
+		bool operator==(const persistent_iterator& rhs) const {
+			return this->node() == rhs.node();
+		}
+		bool operator!=(const persistent_iterator& rhs) const {
+			return !(*this == rhs);
+		}
+
+		// Dereferencing
+		reference operator*() const {
+			return this->node()->pair;
+		}
+		pointer operator->() const {
+			return &this->node()->pair;
+		}
+
+		// Increment: the nodes left on the path are the ancestors still to visit
+		persistent_iterator &operator++() { // Pre-incrementation
+			node_ptr current = this->path[--this->depth];
+			this->pushLeft(current->right);
+			return *this;
+		}
+		persistent_iterator	operator++(int) { // Post-incrementation
+			persistent_iterator tmp(*this);
+			this->operator++();
+			return tmp;
+		}
+
+	private:
+		node_ptr	path[max_depth];
+		int			depth;
+
+		node_ptr node() const {
+			return this->depth ? this->path[this->depth - 1] : NULL;
+		}
+		void pushLeft(node_ptr node) {
+			for (; node; node = node->left)
+				this->path[this->depth++] = node;
+		}
+	};
+}
+
+#endif // PERSISTENT_ITERATOR_HPP
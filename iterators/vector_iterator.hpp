@@ -18,16 +18,9 @@ namespace ft
 		typedef typename iterator::reference			reference;
 		typedef typename iterator::iterator_category	iterator_category;
 		
-		// Canonical form
+		// Canonical form, the copy is the implicit (trivial) one
 		vector_iterator() : p(NULL) {}
 		vector_iterator(pointer p) : p(p) {}
-		vector_iterator(const vector_iterator &it) {
-			*this = it;
-		}
-		vector_iterator	&operator=(const vector_iterator& it) {
-			this->p = it.p;
-			return *this;
-		}
 		template <typename U>
 		operator vector_iterator<const U>() const {
 			vector_iterator<const U> ret((const U*)this->p);
@@ -49,15 +42,16 @@ namespace ft
 		template <typename U, typename V>
 		friend bool operator!=(const vector_iterator<U>& lhs, const vector_iterator<V>& rhs);
 
-		// Dereferencing
-		value_type operator*() const {
+		// Dereferencing, the element is never copied (reference is const for a const_iterator)
+		reference operator*() const {
 			return *this->p;
 		}
-		value_type *operator->() {
+		pointer operator->() const {
 			return this->p;
 		}
-		value_type &operator*() { // Dereferencing as an lvalue
-			return *this->p;
+
+		pointer base() const { // The raw pointer, see unwrap_iterator()
+			return this->p;
 		}
 
 		// Increment & Decrement
@@ -129,13 +123,8 @@ namespace ft
 		}
 
 		// Offset dereference
-		value_type operator[](int i) const {
-			vector_iterator tmp = *this + i;
-			return *tmp;
-		}
-		value_type &operator[](int i) {
-			vector_iterator tmp = *this + i;
-			return *tmp;
+		reference operator[](int i) const {
+			return this->p[i];
 		}
 
 	private:
@@ -147,6 +136,17 @@ namespace ft
 		return vit + n;
 	}
 
+	// The algorithms of vector work on raw pointers when they can, so that
+	// the compiler sees plain pointer loops (and may vectorize them)
+	template <class Iterator>
+	Iterator unwrap_iterator(Iterator it) {
+		return it;
+	}
+	template <class T>
+	T *unwrap_iterator(vector_iterator<T> it) {
+		return it.base();
+	}
+
 	template <typename T, typename U>
 	bool operator==(const vector_iterator<T>& lhs, const vector_iterator<U>& rhs) {
 		if (lhs.p == rhs.p)
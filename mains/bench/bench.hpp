@@ -0,0 +1,559 @@
+#ifndef BENCH_HPP
+# define BENCH_HPP
+
+# include <iostream>
+# include <iomanip>
+# include <sstream>
+# include <string>
+# include <vector>
+# include <algorithm>
+# include <cstdlib>
+# include <cstring>
+# include <unistd.h>
+# include "timer.hpp"
+# include "perf_counters.hpp"
+# include "../../utils/instrumented_allocator.hpp"
+
+namespace bench
+{
+	// Takes the results of the cases, so the compiler cannot drop their work
+	inline void keep(long value) {
+		static volatile long sink = 0;
+		sink = sink + value;
+	}
+
+	// Bytes allocated and not freed yet, kept by a replaced operator new (see
+	// main_bench.cpp), it stays 0 otherwise
+	inline std::size_t& live_bytes() {
+		static std::size_t bytes = 0;
+		return bytes;
+	}
+
+	// Set by the cases while their container is full: bytes per element
+	// allocated since the start of the repetition, and the elements held,
+	// which are not the operations counted when the container has a fixed size
+	struct footprint_state {
+		std::size_t	base;
+		double		perElement;
+		std::size_t	elements;
+	};
+	inline footprint_state& footprint_data() {
+		static footprint_state state = { 0, 0, 0 };
+		return state;
+	}
+	inline void footprint(std::size_t elements) {
+		footprint_state& f = footprint_data();
+		if (elements) {
+			f.perElement = double(live_bytes() - f.base) / elements;
+			f.elements = elements;
+		}
+	}
+
+	// For --report allocs: the cases built with ft::instrumented_allocator
+	// count in ft::allocation_stats::global(), start() is called by the
+	// cases where their measured part begins, so their setup is not counted.
+	// The peak is above the bytes held by the setup
+	inline ft::allocation_stats& setup_stats() {
+		static ft::allocation_stats stats;
+		return stats;
+	}
+	// For --report counters: the hardware counters are sampled by start()
+	// and by stop(), which the cases call where their measured part ends
+	struct measured_region {
+		bool			counting;
+		bool			stopped;
+		counter_sample	from;
+		counter_sample	to;
+	};
+	inline measured_region& region() {
+		static measured_region r;
+		return r;
+	}
+	inline perf_counters& counters() {
+		static perf_counters c;
+		return c;
+	}
+
+	inline void start() {
+		ft::allocation_stats& g = ft::allocation_stats::global();
+		g.peakBytes = g.liveBytes;
+		setup_stats() = g;
+		if (region().counting)
+			counters().sample(region().from);
+	}
+	inline double stop(const timer& t) {
+		double ms = t.elapsed_ms();
+		measured_region& r = region();
+		if (r.counting && !r.stopped) {
+			counters().sample(r.to);
+			r.stopped = true;
+		}
+		return ms;
+	}
+	inline ft::allocation_stats counted_since_start() {
+		ft::allocation_stats s = ft::allocation_stats::global();
+		const ft::allocation_stats& setup = setup_stats();
+		s.allocations -= setup.allocations;
+		s.deallocations -= setup.deallocations;
+		s.totalBytes -= setup.totalBytes;
+		s.peakBytes -= setup.liveBytes;
+		for (int i = 0; i < ft::allocation_stats::buckets; i++)
+			s.histogram[i] -= setup.histogram[i];
+		return s;
+	}
+
+	// Set by the cases for their rows, such as the shape of a tree
+	inline std::string& case_note() {
+		static std::string note;
+		return note;
+	}
+	inline void note(const std::string& text) {
+		case_note() = text;
+	}
+
+	// A case runs its operation n times on a fresh container and returns the
+	// milliseconds of the measured part only (the setup is not timed)
+	typedef double (*case_fn)(std::size_t n);
+
+	struct bench_case {
+		std::string	container;
+		std::string	operation;
+		std::string	element;	// Type of the elements
+		std::size_t	elementSize;
+		std::string	impl;		// ft or std
+		case_fn		run;
+		case_fn		counted;	// The same case with instrumented allocators, or NULL
+	};
+
+	struct options {
+		options() : warmup(3), reps(31), size(100000), sweepMax(0), sweepFactor(10),
+			maxBytes(std::size_t(1) << 30), format("table"), report("time") {}
+		int				warmup;		// Repetitions run before the measures
+		int				reps;
+		std::size_t		size;		// Operations per repetition, the first size of a sweep
+		std::size_t		sweepMax;	// Last size of a sweep, 0 without sweep
+		std::size_t		sweepFactor;
+		std::size_t		maxBytes;	// Sizes whose elements take more are skipped
+		std::string		filter;		// Substring of "container.operation.element"
+		std::string		format;		// table, csv or json
+		std::string		report;		// time, allocs: the counts of one run, or counters
+	};
+
+	// Nanoseconds per operation over the repetitions
+	struct stats {
+		double	min;
+		double	median;
+		double	p99;
+		double	mean;
+		double		bytesPerElement;
+		std::size_t	elements;	// Of the footprint, 0 without one
+	};
+
+	// Data cache sizes, to tell in which level the working set of a run fits
+	struct caches {
+		caches() : l1(0), l2(0), l3(0) {
+# ifdef _SC_LEVEL1_DCACHE_SIZE
+			this->l1 = std::max(0L, sysconf(_SC_LEVEL1_DCACHE_SIZE));
+			this->l2 = std::max(0L, sysconf(_SC_LEVEL2_CACHE_SIZE));
+			this->l3 = std::max(0L, sysconf(_SC_LEVEL3_CACHE_SIZE));
+# endif
+		}
+		const char *level(double bytes) const {
+			if (bytes <= this->l1)
+				return "L1";
+			if (bytes <= this->l2)
+				return "L2";
+			if (bytes <= this->l3)
+				return "L3";
+			return "RAM";
+		}
+		long	l1;
+		long	l2;
+		long	l3;
+	};
+
+	// Nearest rank percentile of sorted samples
+	inline double percentile(const std::vector<double>& sorted, double p) {
+		std::size_t rank = static_cast<std::size_t>(p / 100.0 * sorted.size() + 0.999999);
+		if (rank == 0)
+			rank = 1;
+		if (rank > sorted.size())
+			rank = sorted.size();
+		return sorted[rank - 1];
+	}
+
+	inline stats summarize(std::vector<double> samples) {
+		std::sort(samples.begin(), samples.end());
+		stats s;
+		s.bytesPerElement = 0;
+		s.elements = 0;
+		s.min = samples.front();
+		s.median = percentile(samples, 50);
+		s.p99 = percentile(samples, 99);
+		s.mean = 0;
+		for (std::size_t i = 0; i < samples.size(); i++)
+			s.mean += samples[i];
+		s.mean /= samples.size();
+		return s;
+	}
+
+	// Hardware counts per operation, summed over the repetitions
+	struct counter_stats {
+		double			medianNs;
+		counter_values	perOp;
+	};
+
+	inline counter_stats measure_counters(const bench_case& c, std::size_t size, const options& opt) {
+		measured_region& r = region();
+		for (int i = 0; i < opt.warmup; i++)
+			c.run(size);
+		counter_stats cs;
+		std::vector<double> samples;
+		for (int i = 0; i < COUNTERS; i++) {
+			cs.perOp.count[i] = 0;
+			cs.perOp.valid[i] = true;
+		}
+		r.counting = true;
+		for (int rep = 0; rep < opt.reps; rep++) {
+			r.stopped = false;
+			start();
+			samples.push_back(c.run(size) * 1000000.0 / size);
+			if (!r.stopped)
+				counters().sample(r.to);
+			counter_values d = counters().delta(r.from, r.to);
+			for (int i = 0; i < COUNTERS; i++) {
+				cs.perOp.count[i] += d.count[i] / (double(size) * opt.reps);
+				cs.perOp.valid[i] = cs.perOp.valid[i] && d.valid[i];
+			}
+		}
+		r.counting = false;
+		cs.medianNs = summarize(samples).median;
+		return cs;
+	}
+
+	inline stats measure(const bench_case& c, std::size_t size, const options& opt) {
+		for (int i = 0; i < opt.warmup; i++)
+			c.run(size);
+		std::vector<double> samples;
+		footprint_data().perElement = 0;
+		footprint_data().elements = 0;
+		case_note().clear();
+		for (int i = 0; i < opt.reps; i++) {
+			footprint_data().base = live_bytes();
+			samples.push_back(c.run(size) * 1000000.0 / size);
+		}
+		stats s = summarize(samples);
+		s.bytesPerElement = footprint_data().perElement;
+		s.elements = footprint_data().elements;
+		return s;
+	}
+
+	// MIN:MAX[:FACTOR], the sizes of a sweep
+	inline bool parseSweep(const std::string& value, options& opt) {
+		std::string::size_type colon = value.find(':');
+		if (colon == std::string::npos)
+			return false;
+		opt.size = std::atol(value.c_str());
+		opt.sweepMax = std::atol(value.c_str() + colon + 1);
+		std::string::size_type factor = value.find(':', colon + 1);
+		if (factor != std::string::npos)
+			opt.sweepFactor = std::atol(value.c_str() + factor + 1);
+		return opt.size > 0 && opt.sweepMax >= opt.size && opt.sweepFactor > 1;
+	}
+
+	// --warmup N --reps N --size N --sweep MIN:MAX[:FACTOR] --max-mb N
+	// --filter STR --format table|csv|json --report time|allocs|counters
+	inline bool parse(int argc, char **argv, options& opt) {
+		for (int i = 1; i < argc; i++) {
+			std::string arg(argv[i]);
+			if (i + 1 >= argc) {
+				std::cerr << "bench: missing value for " << arg << std::endl;
+				return false;
+			}
+			std::string value(argv[++i]);
+			if (arg == "--warmup")
+				opt.warmup = std::atoi(value.c_str());
+			else if (arg == "--reps")
+				opt.reps = std::max(1, std::atoi(value.c_str()));
+			else if (arg == "--size")
+				opt.size = std::max(1L, std::atol(value.c_str()));
+			else if (arg == "--sweep" && parseSweep(value, opt))
+				;
+			else if (arg == "--max-mb")
+				opt.maxBytes = std::size_t(std::max(1L, std::atol(value.c_str()))) << 20;
+			else if (arg == "--filter")
+				opt.filter = value;
+			else if (arg == "--format" && (value == "table" || value == "csv" || value == "json"))
+				opt.format = value;
+			else if (arg == "--report" && (value == "time" || value == "allocs" || value == "counters"))
+				opt.report = value;
+			else {
+				std::cerr << "bench: bad option " << arg << " " << value << std::endl;
+				return false;
+			}
+		}
+		return true;
+	}
+
+	class suite
+	{
+	public:
+		suite() : ftMedian(0) {}
+
+		void add(const std::string& container, const std::string& operation,
+				 const std::string& impl, case_fn run, case_fn counted = NULL) {
+			this->add(container, operation, "int", sizeof(int), impl, run, counted);
+		}
+		void add(const std::string& container, const std::string& operation, const std::string& element,
+				 std::size_t elementSize, const std::string& impl, case_fn run, case_fn counted = NULL) {
+			bench_case c;
+			c.container = container;
+			c.operation = operation;
+			c.element = element;
+			c.elementSize = elementSize;
+			c.impl = impl;
+			c.run = run;
+			c.counted = counted;
+			this->cases.push_back(c);
+		}
+
+		// Without sweep every case runs at one size, a sweep runs them at
+		// each size in turn, the ft and std rows of a case stay side by side
+		int run(int argc, char **argv) {
+			options opt;
+			if (!parse(argc, argv, opt))
+				return 1;
+			if (opt.report == "counters" && !counters().available()) {
+				std::cerr << "bench: no hardware counter available (perf_event_open), timings only" << std::endl;
+				opt.report = "time";
+			}
+			this->header(opt);
+			bool first = true;
+			std::size_t last = opt.sweepMax ? opt.sweepMax : opt.size;
+			for (std::size_t size = opt.size; ; size *= opt.sweepFactor) {
+				for (std::size_t i = 0; i < this->cases.size(); i++) {
+					const bench_case& c = this->cases[i];
+					if ((c.container + "." + c.operation + "." + c.element).find(opt.filter) == std::string::npos)
+						continue;
+					if (size * c.elementSize > opt.maxBytes)
+						continue;
+					if (opt.report == "allocs") {
+						if (!c.counted)
+							continue;
+						std::size_t before = ft::allocation_stats::global().liveBytes;
+						start();
+						c.counted(size);
+						ft::allocation_stats counted = counted_since_start();
+						counted.liveBytes -= before;	// Still held after the case: leaked
+						this->allocRow(c, size, counted, opt, first);
+						first = false;
+						continue;
+					}
+					if (opt.report == "counters") {
+						this->counterRow(c, size, measure_counters(c, size, opt), opt, first);
+						first = false;
+						continue;
+					}
+					stats s = measure(c, size, opt);
+					this->row(c, size, s, opt, first);
+					this->ftMedian = (c.impl == "ft") ? s.median : 0;
+					first = false;
+				}
+				if (size > last / opt.sweepFactor)
+					break;
+			}
+			if (opt.format == "json")
+				std::cout << std::endl << "]" << std::endl;
+			return 0;
+		}
+
+	private:
+		std::vector<bench_case>	cases;
+		caches					cache;
+		double					ftMedian;	// Of the previous row, for the ratio of the std row
+
+		void header(const options& opt) const {
+			if (opt.report == "allocs")
+				this->allocHeader(opt);
+			else if (opt.report == "counters")
+				this->counterHeader(opt);
+			else if (opt.format == "csv")
+				std::cout << "container,operation,element,impl,size,reps,min_ns,median_ns,p99_ns,mean_ns,bytes_per_element,fits,note" << std::endl;
+			else if (opt.format == "json")
+				std::cout << "[";
+			else {
+				std::cout << opt.warmup << " warmup + " << opt.reps << " repetitions, ns/op, caches L1d "
+					<< this->cache.l1 / 1024 << "KB L2 " << this->cache.l2 / 1024 << "KB L3 "
+					<< this->cache.l3 / 1024 << "KB" << std::endl;
+				std::cout << std::left << std::setw(10) << "container" << std::setw(16) << "operation"
+					<< std::setw(8) << "element" << std::setw(6) << "impl" << std::right << std::setw(11) << "size"
+					<< std::setw(10) << "min" << std::setw(10) << "median" << std::setw(10) << "p99"
+					<< std::setw(10) << "mean" << std::setw(10) << "B/elem" << std::setw(6) << "fits"
+					<< std::setw(9) << "ft/std" << std::endl;
+			}
+		}
+
+		void row(const bench_case& c, std::size_t size, const stats& s, const options& opt, bool first) const {
+			// The working set is the container the footprint was taken on
+			const char *fits = s.elements ? this->cache.level(s.bytesPerElement * s.elements) : "-";
+			if (opt.format == "csv")
+				std::cout << c.container << "," << c.operation << "," << c.element << "," << c.impl << ","
+					<< size << "," << opt.reps << "," << s.min << "," << s.median << "," << s.p99 << ","
+					<< s.mean << "," << s.bytesPerElement << "," << fits << ",\"" << case_note() << "\"" << std::endl;
+			else if (opt.format == "json")
+				std::cout << (first ? "\n" : ",\n") << "  {\"container\": \"" << c.container
+					<< "\", \"operation\": \"" << c.operation << "\", \"element\": \"" << c.element
+					<< "\", \"impl\": \"" << c.impl << "\", \"size\": " << size << ", \"reps\": " << opt.reps
+					<< ", \"min_ns\": " << s.min << ", \"median_ns\": " << s.median
+					<< ", \"p99_ns\": " << s.p99 << ", \"mean_ns\": " << s.mean
+					<< ", \"bytes_per_element\": " << s.bytesPerElement << ", \"fits\": \"" << fits
+					<< "\", \"note\": \"" << case_note() << "\"}";
+			else {
+				std::cout << std::left << std::setw(10) << c.container << std::setw(16) << c.operation
+					<< std::setw(8) << c.element << std::setw(6) << c.impl << std::right << std::setw(11) << size
+					<< std::fixed << std::setprecision(2) << std::setw(10) << s.min << std::setw(10) << s.median
+					<< std::setw(10) << s.p99 << std::setw(10) << s.mean << std::setw(10) << s.bytesPerElement
+					<< std::setw(6) << fits;
+				if (c.impl == "std" && this->ftMedian > 0 && s.median > 0)
+					std::cout << std::setw(9) << this->ftMedian / s.median;
+				else if (!case_note().empty())
+					std::cout << std::setw(9) << "";
+				if (!case_note().empty())
+					std::cout << "  " << case_note();
+				std::cout << std::endl;
+			}
+		}
+
+		void allocHeader(const options& opt) const {
+			if (opt.format == "csv")
+				std::cout << "container,operation,element,impl,size,allocations,deallocations,allocs_per_op,bytes_per_op,peak_bytes,leaked_bytes,histogram" << std::endl;
+			else if (opt.format == "json")
+				std::cout << "[";
+			else {
+				std::cout << "allocations of one run, histogram: allocations per size up to" << std::endl;
+				std::cout << std::left << std::setw(10) << "container" << std::setw(16) << "operation"
+					<< std::setw(8) << "element" << std::setw(6) << "impl" << std::right << std::setw(11) << "size"
+					<< std::setw(10) << "allocs/op" << std::setw(10) << "bytes/op" << std::setw(12) << "peak"
+					<< std::setw(8) << "leaked" << "  histogram" << std::endl;
+			}
+		}
+
+		// "16:1000 4K:10", the non empty buckets
+		static std::string histogram(const ft::allocation_stats& s, const char *sep, bool json) {
+			std::ostringstream out;
+			bool first = true;
+			for (int i = 0; i < ft::allocation_stats::buckets; i++) {
+				if (!s.histogram[i])
+					continue;
+				std::size_t bytes = std::size_t(1) << i;
+				out << (first ? "" : sep) << (json ? "\"" : "");
+				if (bytes >= (1 << 20))
+					out << (bytes >> 20) << "M";
+				else if (bytes >= (1 << 10))
+					out << (bytes >> 10) << "K";
+				else
+					out << bytes;
+				out << (json ? "\": " : ":") << s.histogram[i];
+				first = false;
+			}
+			return out.str();
+		}
+
+		void allocRow(const bench_case& c, std::size_t size, const ft::allocation_stats& s,
+					  const options& opt, bool first) const {
+			double perOp = double(s.allocations) / size;
+			double bytesPerOp = double(s.totalBytes) / size;
+			if (opt.format == "csv")
+				std::cout << c.container << "," << c.operation << "," << c.element << "," << c.impl << ","
+					<< size << "," << s.allocations << "," << s.deallocations << "," << perOp << ","
+					<< bytesPerOp << "," << s.peakBytes << "," << s.liveBytes << "," << histogram(s, " ", false) << std::endl;
+			else if (opt.format == "json")
+				std::cout << (first ? "\n" : ",\n") << "  {\"container\": \"" << c.container
+					<< "\", \"operation\": \"" << c.operation << "\", \"element\": \"" << c.element
+					<< "\", \"impl\": \"" << c.impl << "\", \"size\": " << size
+					<< ", \"allocations\": " << s.allocations << ", \"deallocations\": " << s.deallocations
+					<< ", \"allocs_per_op\": " << perOp << ", \"bytes_per_op\": " << bytesPerOp
+					<< ", \"peak_bytes\": " << s.peakBytes << ", \"leaked_bytes\": " << s.liveBytes
+					<< ", \"histogram\": {" << histogram(s, ", ", true) << "}}";
+			else
+				std::cout << std::left << std::setw(10) << c.container << std::setw(16) << c.operation
+					<< std::setw(8) << c.element << std::setw(6) << c.impl << std::right << std::setw(11) << size
+					<< std::fixed << std::setprecision(3) << std::setw(10) << perOp << std::setprecision(1)
+					<< std::setw(10) << bytesPerOp << std::setw(12) << s.peakBytes << std::setw(8) << s.liveBytes
+					<< "  " << histogram(s, " ", false) << std::endl;
+		}
+
+		void counterHeader(const options& opt) const {
+			if (opt.format == "csv") {
+				std::cout << "container,operation,element,impl,size,reps,median_ns";
+				for (int i = 0; i < COUNTERS; i++)
+					std::cout << "," << counter_name(i) << "_per_op";
+				std::cout << std::endl;
+			}
+			else if (opt.format == "json")
+				std::cout << "[";
+			else {
+				std::cout << opt.warmup << " warmup + " << opt.reps << " repetitions, counts per operation"
+					" of the user space, - when the counter is not available" << std::endl;
+				std::cout << std::left << std::setw(10) << "container" << std::setw(16) << "operation"
+					<< std::setw(8) << "element" << std::setw(6) << "impl" << std::right << std::setw(11) << "size"
+					<< std::setw(10) << "median" << std::setw(10) << "cycles" << std::setw(10) << "instr"
+					<< std::setw(6) << "IPC" << std::setw(10) << "L1d miss" << std::setw(10) << "LLC miss"
+					<< std::setw(10) << "br miss" << std::endl;
+			}
+		}
+
+		static void counterCell(const counter_values& v, int id, int width) {
+			if (v.valid[id])
+				std::cout << std::setw(width) << v.count[id];
+			else
+				std::cout << std::setw(width) << "-";
+		}
+
+		void counterRow(const bench_case& c, std::size_t size, const counter_stats& s,
+						const options& opt, bool first) const {
+			const counter_values& v = s.perOp;
+			if (opt.format == "csv") {
+				std::cout << c.container << "," << c.operation << "," << c.element << "," << c.impl << ","
+					<< size << "," << opt.reps << "," << s.medianNs;
+				for (int i = 0; i < COUNTERS; i++) {
+					std::cout << ",";
+					if (v.valid[i])
+						std::cout << v.count[i];
+				}
+				std::cout << std::endl;
+			}
+			else if (opt.format == "json") {
+				std::cout << (first ? "\n" : ",\n") << "  {\"container\": \"" << c.container
+					<< "\", \"operation\": \"" << c.operation << "\", \"element\": \"" << c.element
+					<< "\", \"impl\": \"" << c.impl << "\", \"size\": " << size << ", \"reps\": " << opt.reps
+					<< ", \"median_ns\": " << s.medianNs;
+				for (int i = 0; i < COUNTERS; i++) {
+					std::cout << ", \"" << counter_name(i) << "_per_op\": ";
+					if (v.valid[i])
+						std::cout << v.count[i];
+					else
+						std::cout << "null";
+				}
+				std::cout << "}";
+			}
+			else {
+				std::cout << std::left << std::setw(10) << c.container << std::setw(16) << c.operation
+					<< std::setw(8) << c.element << std::setw(6) << c.impl << std::right << std::setw(11) << size
+					<< std::fixed << std::setprecision(2) << std::setw(10) << s.medianNs;
+				counterCell(v, CYCLES, 10);
+				counterCell(v, INSTRUCTIONS, 10);
+				if (v.valid[CYCLES] && v.valid[INSTRUCTIONS] && v.count[CYCLES] > 0)
+					std::cout << std::setw(6) << v.count[INSTRUCTIONS] / v.count[CYCLES];
+				else
+					std::cout << std::setw(6) << "-";
+				counterCell(v, L1D_MISSES, 10);
+				counterCell(v, LLC_MISSES, 10);
+				counterCell(v, BRANCH_MISSES, 10);
+				std::cout << std::endl;
+			}
+		}
+	};
+}
+
+#endif // BENCH_HPP
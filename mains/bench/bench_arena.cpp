@@ -0,0 +1,85 @@
+// c++ -O2 -std=c++98 mains/bench/bench_arena.cpp -o bench_arena && ./bench_arena [requests]
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <vector>
+#include <functional>
+#include <stdlib.h>
+
+#include "../../containers/vector.hpp"
+#include "../../containers/map.hpp"
+#include "../../utils/arena_allocator.hpp"
+#include "timer.hpp"
+
+// A request handler: tokenizes the request into a vector, counts the
+// tokens in a map and keeps the positions of each token in a vector of
+// vectors, then everything is destroyed at the end of the request
+template <class Vector, class Map, class Index>
+long handle(int request, typename Vector::allocator_type alloc) {
+	Vector tokens(alloc);
+	int n = 200 + request % 300;
+	for (int i = 0; i < n; i++)
+		tokens.push_back((i * 7919 + request) % 128);
+	Map counts(std::less<int>(), alloc);
+	for (int i = 0; i < n; i++)
+		counts[tokens[i]]++;
+	Index positions(16, Vector(alloc), alloc);
+	for (int i = 0; i < n; i++)
+		positions[tokens[i] % 16].push_back(i);
+	return counts.size() + positions[request % 16].size();
+}
+
+template <template <class> class Allocator>
+struct containers {
+	typedef Allocator<int>											int_allocator;
+	typedef ft::vector<int, int_allocator>							ft_vector;
+	typedef ft::map<int, int, std::less<int>,
+		Allocator<ft::pair<const int, int> > >						ft_map;
+	typedef ft::vector<ft_vector, Allocator<ft_vector> >			ft_index;
+	typedef std::vector<int, int_allocator>							std_vector;
+	typedef std::map<int, int, std::less<int>,
+		Allocator<std::pair<const int, int> > >						std_map;
+	typedef std::vector<std_vector, Allocator<std_vector> >			std_index;
+};
+
+static void report(const std::string& name, double ms, int requests, long checksum) {
+	std::cout << std::left << std::setw(40) << name << std::setw(10) << ms << " ms   "
+		<< std::setw(8) << ms * 1000 / requests << " us/request  (checksum " << checksum << ")" << std::endl;
+}
+
+int main(int argc, char **argv) {
+	int requests = (argc > 1) ? atoi(argv[1]) : 20000;
+	typedef containers<std::allocator>			heap;
+	typedef containers<ft::arena_allocator>		arena;
+	long checksum = 0;
+
+	bench::timer t;
+	for (int r = 0; r < requests; r++)
+		checksum += handle<heap::ft_vector, heap::ft_map, heap::ft_index>(r, std::allocator<int>());
+	report("ft containers, std::allocator", t.elapsed_ms(), requests, checksum);
+
+	ft::arena memory;
+	checksum = 0;
+	t.reset();
+	for (int r = 0; r < requests; r++) {
+		checksum += handle<arena::ft_vector, arena::ft_map, arena::ft_index>(r, memory);
+		memory.reset();
+	}
+	report("ft containers, ft::arena_allocator", t.elapsed_ms(), requests, checksum);
+
+	checksum = 0;
+	t.reset();
+	for (int r = 0; r < requests; r++)
+		checksum += handle<heap::std_vector, heap::std_map, heap::std_index>(r, std::allocator<int>());
+	report("std containers, std::allocator", t.elapsed_ms(), requests, checksum);
+
+	checksum = 0;
+	t.reset();
+	for (int r = 0; r < requests; r++) {
+		checksum += handle<arena::std_vector, arena::std_map, arena::std_index>(r, memory);
+		memory.reset();
+	}
+	report("std containers, ft::arena_allocator", t.elapsed_ms(), requests, checksum);
+	std::cout << "arena chunks: " << memory.capacity() / 1024 << " KB" << std::endl;
+	return 0;
+}
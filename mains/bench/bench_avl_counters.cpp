@@ -0,0 +1,117 @@
+// c++ -O2 -std=c++98 mains/bench/bench_avl_counters.cpp -o bench_avl_counters && ./bench_avl_counters [count]
+#define FT_AVL_STATS
+#include <iostream>
+#include <iomanip>
+#include <functional>
+#include <map>
+#include <vector>
+#include <stdlib.h>
+
+#include "../../containers/map.hpp"
+#include "timer.hpp"
+
+// The comparator of std::map, its calls are counted as those of ft::map are
+static std::size_t stdComparisons = 0;
+
+struct counting_less : public std::binary_function<int, int, bool>
+{
+	bool operator()(int lhs, int rhs) const {
+		stdComparisons++;
+		return lhs < rhs;
+	}
+};
+
+typedef ft::map<int, int>					ft_map;
+typedef std::map<int, int, counting_less>	std_map;
+
+static void header() {
+	std::cout << std::left << std::setw(10) << "operation" << std::right << std::setw(10) << "ns/op"
+		<< std::setw(10) << "cmp/op" << std::setw(12) << "std cmp/op" << std::setw(10) << "rot/op"
+		<< std::setw(11) << "alloc/op" << std::setw(10) << "free/op" << std::setw(11) << "climb/op" << std::endl;
+}
+
+static void row(const char *name, double ms, std::size_t n) {
+	const ft::avl_counters& c = ft_map::hot_path_counters();
+	std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << ms * 1000000.0 / n
+		<< std::setw(10) << double(c.comparisons) / n
+		<< std::setw(12) << double(stdComparisons) / n
+		<< std::setw(10) << double(c.leftRotations + c.rightRotations) / n
+		<< std::setw(11) << double(c.nodeAllocations) / n
+		<< std::setw(10) << double(c.nodeFrees) / n
+		<< std::setw(11) << double(c.parentClimbs) / n << std::endl;
+	ft_map::reset_hot_path_counters();
+	stdComparisons = 0;
+}
+
+// Random keys: each operation is run on ft::map then std::map, the
+// counters are per operation of ft::map
+static void run(std::size_t n) {
+	std::vector<int> keys(n);
+	for (std::size_t i = 0; i < n; i++)
+		keys[i] = static_cast<int>(i);
+	srand(42);
+	for (std::size_t i = n; i > 1; i--)
+		std::swap(keys[i - 1], keys[rand() % i]);
+
+	std::cout << n << " keys" << std::endl;
+	header();
+	ft_map fm;
+	std_map sm;
+	ft_map::reset_hot_path_counters();
+	stdComparisons = 0;
+
+	bench::timer t;
+	for (std::size_t i = 0; i < n; i++)
+		fm.insert(ft::make_pair(keys[i], keys[i]));
+	double ms = t.elapsed_ms();
+	for (std::size_t i = 0; i < n; i++)
+		sm.insert(std::make_pair(keys[i], keys[i]));
+	row("insert", ms, n);
+
+	long found = 0;
+	t.reset();
+	for (std::size_t i = 0; i < n; i++)
+		found += fm.find(keys[i])->second;
+	ms = t.elapsed_ms();
+	for (std::size_t i = 0; i < n; i++)
+		found -= sm.find(keys[i])->second;
+	row("find", ms, n);
+
+	long sum = 0;
+	t.reset();
+	for (ft_map::iterator it = fm.begin(); it != fm.end(); it++)
+		sum += it->second;
+	ms = t.elapsed_ms();
+	row("iterate", ms, n);
+
+	t.reset();
+	for (ft_map::reverse_iterator it = fm.rbegin(); it != fm.rend(); it++)
+		sum -= it->second;
+	ms = t.elapsed_ms();
+	row("reverse", ms, n);
+
+	t.reset();
+	{
+		ft_map copy(fm);
+		sum += copy.size();
+	}
+	ms = t.elapsed_ms();
+	row("copy", ms, n);
+
+	t.reset();
+	for (std::size_t i = 0; i < n; i += 2)
+		fm.erase(keys[i]);
+	ms = t.elapsed_ms();
+	for (std::size_t i = 0; i < n; i += 2)
+		sm.erase(keys[i]);
+	row("erase", ms, (n + 1) / 2);
+	std::cout << "(checksum " << found + sum << ")" << std::endl << std::endl;
+}
+
+int main(int argc, char **argv) {
+	std::size_t count = (argc > 1) ? atol(argv[1]) : 1000000;
+	for (std::size_t n = 1000; n <= count; n *= 10)
+		run(n);
+	return 0;
+}
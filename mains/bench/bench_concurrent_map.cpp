@@ -0,0 +1,192 @@
+// c++ -O2 -std=c++98 -pthread mains/bench/bench_concurrent_map.cpp -o bench_concurrent && ./bench_concurrent [keys] [ms]
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <pthread.h>
+#include <unistd.h>
+#include <stdlib.h>
+
+#include "../../containers/map.hpp"
+#include "../../containers/concurrent_map.hpp"
+#include "timer.hpp"
+
+// ft::map behind one mutex, what the services do today
+class mutex_map
+{
+public:
+	mutex_map() {
+		pthread_mutex_init(&this->lock, NULL);
+	}
+	~mutex_map() {
+		pthread_mutex_destroy(&this->lock);
+	}
+	bool find(int key, long& value) {
+		pthread_mutex_lock(&this->lock);
+		ft::map<int, long>::iterator it = this->m.find(key);
+		bool found = it != this->m.end();
+		if (found)
+			value = it->second;
+		pthread_mutex_unlock(&this->lock);
+		return found;
+	}
+	void assign(int key, long value) {
+		pthread_mutex_lock(&this->lock);
+		this->m.insert_or_assign(key, value);
+		pthread_mutex_unlock(&this->lock);
+	}
+private:
+	ft::map<int, long>	m;
+	pthread_mutex_t		lock;
+};
+
+// ft::map behind a reader-writer lock, the readers only wait for the writer
+class rwlock_map
+{
+public:
+	rwlock_map() {
+		pthread_rwlock_init(&this->lock, NULL);
+	}
+	~rwlock_map() {
+		pthread_rwlock_destroy(&this->lock);
+	}
+	bool find(int key, long& value) {
+		pthread_rwlock_rdlock(&this->lock);
+		ft::map<int, long>::iterator it = this->m.find(key);
+		bool found = it != this->m.end();
+		if (found)
+			value = it->second;
+		pthread_rwlock_unlock(&this->lock);
+		return found;
+	}
+	void assign(int key, long value) {
+		pthread_rwlock_wrlock(&this->lock);
+		this->m.insert_or_assign(key, value);
+		pthread_rwlock_unlock(&this->lock);
+	}
+private:
+	ft::map<int, long>	m;
+	pthread_rwlock_t	lock;
+};
+
+class snapshot_map
+{
+public:
+	bool find(int key, long& value) {
+		return this->m.find(key, value);
+	}
+	void assign(int key, long value) {
+		this->m.insert_or_assign(key, value);
+	}
+private:
+	ft::concurrent_map<int, long>	m;
+};
+
+template <class Map>
+struct shared {
+	Map		map;
+	int		keys;
+	int		stop;
+};
+
+struct worker {
+	void	*state;
+	int		pause;		// Of the writer, in microseconds
+	long	operations;
+	long	checksum;
+};
+
+// Random finds until stop
+template <class Map>
+void *reader(void *arg) {
+	worker& w = *static_cast<worker *>(arg);
+	shared<Map>& s = *static_cast<shared<Map> *>(w.state);
+	unsigned int key = static_cast<unsigned int>(reinterpret_cast<size_t>(&w));
+	long value;
+	while (!__atomic_load_n(&s.stop, __ATOMIC_RELAXED)) {
+		for (int i = 0; i < 256; i++) {
+			key = key * 1103515245 + 12345;
+			if (s.map.find(static_cast<int>((key >> 8) % s.keys), value))
+				w.checksum += value;
+		}
+		w.operations += 256;
+	}
+	return NULL;
+}
+
+// Updates of existing keys until stop, pausing pause microseconds between
+// two writes: 0 is a writer as fast as the map lets it be
+template <class Map>
+void *writer(void *arg) {
+	worker& w = *static_cast<worker *>(arg);
+	shared<Map>& s = *static_cast<shared<Map> *>(w.state);
+	unsigned int key = 42;
+	while (!__atomic_load_n(&s.stop, __ATOMIC_RELAXED)) {
+		key = key * 1103515245 + 12345;
+		s.map.assign(static_cast<int>((key >> 8) % s.keys), w.operations);
+		w.operations++;
+		if (w.pause)
+			usleep(w.pause);
+	}
+	return NULL;
+}
+
+template <class Map>
+void run(const std::string& name, int readers, int pause, int keys, int ms) {
+	shared<Map> *s = new shared<Map>;
+	s->keys = keys;
+	s->stop = 0;
+	for (int i = 0; i < keys; i++)
+		s->map.assign(i, i);
+
+	worker workers[33];
+	pthread_t threads[33];
+	for (int i = 0; i <= readers; i++) {
+		workers[i].state = s;
+		workers[i].pause = pause;
+		workers[i].operations = 0;
+		workers[i].checksum = 0;
+	}
+	bench::timer t;
+	for (int i = 0; i < readers; i++)
+		pthread_create(&threads[i], NULL, reader<Map>, &workers[i]);
+	pthread_create(&threads[readers], NULL, writer<Map>, &workers[readers]);
+	usleep(ms * 1000);
+	__atomic_store_n(&s->stop, 1, __ATOMIC_RELAXED);
+	long reads = 0, checksum = 0;
+	for (int i = 0; i <= readers; i++) {
+		pthread_join(threads[i], NULL);
+		if (i < readers)
+			reads += workers[i].operations;
+		checksum += workers[i].checksum;
+	}
+	double elapsed = t.elapsed_ms();
+	delete s;
+
+	std::cout << std::left << std::setw(18) << name << std::right << std::setw(8) << readers
+		<< std::fixed << std::setprecision(2) << std::setw(14) << reads / elapsed / 1000.0
+		<< std::setw(14) << workers[readers].operations / elapsed << "  (checksum " << checksum % 1000 << ")" << std::endl;
+}
+
+template <class Map>
+void sweep(const std::string& name, int pause, int keys, int ms) {
+	for (int readers = 1; readers <= 32; readers *= 2)
+		run<Map>(name, readers, pause, keys, ms);
+}
+
+// N reader threads and one writer on a map of keys entries, each for ms
+// milliseconds: the writer updates as fast as it can, then once every
+// 100 microseconds as a read-mostly service would
+int main(int argc, char **argv) {
+	int keys = (argc > 1) ? atoi(argv[1]) : 100000;
+	int ms = (argc > 2) ? atoi(argv[2]) : 300;
+	std::cout << keys << " keys, " << sysconf(_SC_NPROCESSORS_ONLN) << " CPUs" << std::endl;
+	for (int pause = 0; pause <= 100; pause += 100) {
+		std::cout << std::endl << (pause ? "writer pausing 100us" : "writer flat out") << std::endl;
+		std::cout << std::left << std::setw(18) << "map" << std::right << std::setw(8) << "readers"
+			<< std::setw(14) << "Mreads/s" << std::setw(14) << "Kwrites/s" << std::endl;
+		sweep<mutex_map>("ft::map + mutex", pause, keys, ms);
+		sweep<rwlock_map>("ft::map + rwlock", pause, keys, ms);
+		sweep<snapshot_map>("concurrent_map", pause, keys, ms);
+	}
+	return 0;
+}
@@ -0,0 +1,110 @@
+// c++ -O2 -std=c++98 mains/bench/bench_const_iteration.cpp -o bench_const_it && ./bench_const_it [count]
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <stdlib.h>
+#include <new>
+
+#include "../../containers/map.hpp"
+#include "../../containers/vector.hpp"
+#include "timer.hpp"
+
+// Every allocation is counted: a dereference that copies a long string shows up
+// (noinline: gcc would pair the inlined malloc/free with new/delete and warn)
+static size_t g_allocations = 0;
+
+__attribute__((noinline)) void *operator new(std::size_t size) throw(std::bad_alloc) {
+	g_allocations++;
+	void *p = malloc(size ? size : 1);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+__attribute__((noinline)) void operator delete(void *p) throw() {
+	free(p);
+}
+
+typedef ft::map<std::string, std::string>	map_type;
+typedef ft::vector<std::string>				vector_type;
+
+static std::string longString(int i) {
+	std::ostringstream ss;
+	ss << "a_string_that_does_not_fit_in_the_small_string_buffer_" << i;
+	return ss.str();
+}
+
+// The iterators are dereferenced as const objects, as in the algorithms and
+// functors that take them by const reference
+template <class It>
+size_t firstSize(const It& it) {
+	return (*it).first.size();
+}
+template <class It>
+size_t secondSize(const It& it) {
+	return it->second.size();
+}
+template <class It>
+size_t elementSize(const It& it) {
+	return (*it).size();
+}
+template <class It>
+size_t elementSize(const It& it, int i) {
+	return it[i].size();
+}
+
+static void report(const std::string& what, double ms, size_t allocations, size_t checksum) {
+	std::cout << std::left << std::setw(32) << what << std::setw(10) << ms << " ms  "
+		<< std::setw(10) << allocations << " allocations  (checksum " << checksum << ")" << std::endl;
+}
+
+int main(int argc, char **argv) {
+	int count = (argc > 1) ? atoi(argv[1]) : 200000;
+	map_type m;
+	vector_type v;
+	for (int i = 0; i < count; i++) {
+		m[longString(i)] = longString(i);
+		v.push_back(longString(i));
+	}
+	const map_type& cm = m;
+	const vector_type& cv = v;
+	std::cout << "const iteration over " << count << " string elements" << std::endl;
+
+	size_t sum = 0, before = g_allocations;
+	bench::timer t;
+	for (map_type::const_iterator it = cm.begin(); it != cm.end(); it++)
+		sum += firstSize(it);
+	report("map const_iterator *it", t.elapsed_ms(), g_allocations - before, sum);
+
+	sum = 0, before = g_allocations;
+	t.reset();
+	for (map_type::const_iterator it = cm.begin(); it != cm.end(); it++)
+		sum += secondSize(it);
+	report("map const_iterator ->", t.elapsed_ms(), g_allocations - before, sum);
+
+	sum = 0, before = g_allocations;
+	t.reset();
+	for (map_type::const_reverse_iterator it = cm.rbegin(); it != cm.rend(); it++)
+		sum += firstSize(it);
+	report("map const_reverse_iterator", t.elapsed_ms(), g_allocations - before, sum);
+
+	sum = 0, before = g_allocations;
+	t.reset();
+	for (vector_type::const_iterator it = cv.begin(); it != cv.end(); it++)
+		sum += elementSize(it);
+	report("vector const_iterator *it", t.elapsed_ms(), g_allocations - before, sum);
+
+	sum = 0, before = g_allocations;
+	t.reset();
+	vector_type::const_iterator first = cv.begin();
+	for (int i = 0; i < count; i++)
+		sum += elementSize(first, i);
+	report("vector const_iterator []", t.elapsed_ms(), g_allocations - before, sum);
+
+	sum = 0, before = g_allocations;
+	t.reset();
+	for (vector_type::const_reverse_iterator it = cv.rbegin(); it != cv.rend(); it++)
+		sum += elementSize(it);
+	report("vector const_reverse_iterator", t.elapsed_ms(), g_allocations - before, sum);
+	return 0;
+}
@@ -0,0 +1,87 @@
+// c++ -O2 -std=c++98 mains/bench/bench_emplace.cpp -o bench_emplace && ./bench_emplace [count]
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <stdlib.h>
+
+#include "../../containers/stack.hpp"
+#include "../../containers/deque.hpp"
+#include "../../containers/map.hpp"
+#include "timer.hpp"
+
+#define BUFFER_SIZE 4096
+
+// The 4KB buffer of mains/subject.cpp, filled from a seed by its constructor
+struct Buffer
+{
+	Buffer() : idx(0) {
+		std::memset(this->buff, 0, BUFFER_SIZE);
+	}
+	Buffer(int idx, char fill) : idx(idx) {
+		std::memset(this->buff, fill, BUFFER_SIZE);
+	}
+	int idx;
+	char buff[BUFFER_SIZE];
+};
+
+static void report(const std::string& name, double copy, double emplace) {
+	std::cout << std::left << std::setw(44) << name << "copy " << std::setw(10) << copy
+		<< " ms   emplace " << std::setw(10) << emplace << " ms" << std::endl;
+}
+
+template <class Stack>
+void runStack(const std::string& name, int count) {
+	long checksum = 0;
+	bench::timer t;
+	{
+		Stack s;
+		for (int i = 0; i < count; i++)
+			s.push(Buffer(i, 'a'));
+		checksum += s.top().idx;
+	}
+	double copy = t.elapsed_ms();
+	t.reset();
+	{
+		Stack s;
+		for (int i = 0; i < count; i++)
+			s.emplace(i, 'a');
+		checksum += s.top().idx;
+	}
+	report(name, copy, t.elapsed_ms());
+	if (checksum == 42)
+		std::cout << std::endl;
+}
+
+void runMap(int count) {
+	long checksum = 0;
+	bench::timer t;
+	{
+		ft::map<int, Buffer> m;
+		for (int i = 0; i < count; i++)
+			m.insert(ft::make_pair(i, Buffer(i, 'a')));
+		checksum += m.size();
+	}
+	double copy = t.elapsed_ms();
+	t.reset();
+	{
+		ft::map<int, Buffer> m;
+		Buffer buffer(0, 'a');
+		for (int i = 0; i < count; i++) {
+			buffer.idx = i;
+			m.emplace(i, buffer);
+		}
+		checksum += m.size();
+	}
+	report("ft::map<int, Buffer> insert / emplace", copy, t.elapsed_ms());
+	if (checksum == 42)
+		std::cout << std::endl;
+}
+
+int main(int argc, char **argv) {
+	int count = (argc > 1) ? atoi(argv[1]) : 100000;
+	std::cout << count << " buffers of " << sizeof(Buffer) << " bytes" << std::endl;
+	runStack<ft::stack<Buffer> >("ft::stack<Buffer> (ft::vector)", count);
+	runStack<ft::stack<Buffer, ft::deque<Buffer> > >("ft::stack<Buffer, ft::deque>", count);
+	runMap(count);
+	return 0;
+}
@@ -0,0 +1,87 @@
+// c++ -O2 -std=c++98 [-mavx2] mains/bench/bench_lexicographical.cpp -o bench_lexico && ./bench_lexico
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <stdlib.h>
+
+#include "../../utils/lexicographical_compare.hpp"
+#include "timer.hpp"
+
+// Element by element, the generic template called with any other iterator
+template <class T>
+bool loopLess(const T *first1, const T *last1, const T *first2, const T *last2) {
+	return ft::lexicographical_compare<const T*, const T*>(first1, last1, first2, last2);
+}
+
+// Two equal buffers of size bytes but for their last element, compared
+// until about 1GB has been scanned; returns GB/s
+template <class T>
+double throughput(bool (*compare)(const T*, const T*, const T*, const T*),
+				  std::size_t bytes, int& checksum) {
+	std::size_t n = bytes / sizeof(T);
+	T *a = new T[n];
+	T *b = new T[n];
+	for (std::size_t i = 0; i < n; i++) {
+		a[i] = T(i % 100);
+		b[i] = T(i % 100);
+	}
+	b[n - 1] = T(a[n - 1] + 1);
+	std::size_t rounds = std::max<std::size_t>(1, (std::size_t(1) << 30) / bytes);
+	bench::timer t;
+	for (std::size_t r = 0; r < rounds; r++)
+		checksum += compare(a, a + n, b, b + n);
+	double ms = t.elapsed_ms();
+	delete[] a;
+	delete[] b;
+	return (double(bytes) * rounds / (1 << 30)) / (ms / 1000.0);
+}
+
+template <class T>
+bool ftLess(const T *first1, const T *last1, const T *first2, const T *last2) {
+	return ft::lexicographical_compare(first1, last1, first2, last2);
+}
+// Pointers to non-const elements take the same fast path
+template <class T>
+bool ftMutableLess(const T *first1, const T *last1, const T *first2, const T *last2) {
+	return ft::lexicographical_compare(const_cast<T*>(first1), const_cast<T*>(last1),
+									   const_cast<T*>(first2), const_cast<T*>(last2));
+}
+template <class T>
+bool stdLess(const T *first1, const T *last1, const T *first2, const T *last2) {
+	return std::lexicographical_compare(first1, last1, first2, last2);
+}
+
+template <class T>
+void run(const std::string& name, int& checksum) {
+	std::cout << name << " (GB/s)" << std::endl;
+	std::cout << std::left << std::setw(10) << "size" << std::setw(12) << "loop"
+		<< std::setw(12) << "ft" << std::setw(12) << "ft T*" << std::setw(12) << "std" << std::endl;
+	for (std::size_t bytes = 1024; bytes <= (std::size_t(64) << 20); bytes *= 4) {
+		std::ostringstream size;
+		if (bytes >= (1 << 20))
+			size << (bytes >> 20) << "MB";
+		else
+			size << (bytes >> 10) << "KB";
+		std::cout << std::left << std::setw(10) << size.str() << std::setw(12) << throughput<T>(loopLess<T>, bytes, checksum)
+			<< std::setw(12) << throughput<T>(ftLess<T>, bytes, checksum)
+			<< std::setw(12) << throughput<T>(ftMutableLess<T>, bytes, checksum)
+			<< std::setw(12) << throughput<T>(stdLess<T>, bytes, checksum) << std::endl;
+	}
+}
+
+int main() {
+	int checksum = 0;
+#if defined(__AVX2__)
+	std::cout << "kernel: AVX2" << std::endl;
+#elif defined(__SSE2__)
+	std::cout << "kernel: SSE2" << std::endl;
+#else
+	std::cout << "kernel: scalar" << std::endl;
+#endif
+	run<unsigned char>("unsigned char (memcmp)", checksum);
+	run<char>("char", checksum);
+	run<int>("int", checksum);
+	std::cout << "checksum " << checksum << std::endl;
+	return 0;
+}
@@ -0,0 +1,47 @@
+// c++ -O2 -std=c++98 mains/bench/bench_map_range_erase.cpp -o bench_range_erase && ./bench_range_erase [count]
+#include <iostream>
+#include <iomanip>
+#include <stdlib.h>
+
+#include "../../containers/map.hpp"
+#include "timer.hpp"
+
+typedef ft::map<int, int> map_type;
+
+// Time-windowed eviction: the oldest tenth of the keys is dropped at each round
+int main(int argc, char **argv) {
+	int count = (argc > 1) ? atoi(argv[1]) : 1000000;
+	int rounds = 10;
+	int window = count / rounds;
+	map_type slow, fast;
+	for (int i = 0; i < count; i++) {
+		slow.insert(ft::make_pair(i, i));
+		fast.insert(ft::make_pair(i, i));
+	}
+	std::cout << "ft::map eviction of " << window << " keys, " << rounds << " rounds" << std::endl;
+
+	bench::timer t;
+	for (int r = 0; r < rounds; r++)
+		for (int k = r * window; k < (r + 1) * window; k++)
+			slow.erase(k);
+	double keyByKey = t.elapsed_ms();
+	t.reset();
+	for (int r = 0; r < rounds; r++)
+		fast.erase(fast.begin(), fast.lower_bound((r + 1) * window));
+	double range = t.elapsed_ms();
+	std::cout << std::left << "erase key by key: " << std::setw(10) << keyByKey << " ms" << std::endl;
+	std::cout << std::left << "range erase:      " << std::setw(10) << range << " ms" << std::endl;
+
+	for (int i = 0; i < count; i++)
+		fast.insert(ft::make_pair(i, i));
+	t.reset();
+	map_type upper = fast.split(count / 2);
+	double split = t.elapsed_ms();
+	t.reset();
+	fast.splice(upper);
+	double splice = t.elapsed_ms();
+	std::cout << std::left << "split in half:    " << std::setw(10) << split << " ms" << std::endl;
+	std::cout << std::left << "splice back:      " << std::setw(10) << splice << " ms (size "
+		<< fast.size() << ")" << std::endl;
+	return 0;
+}
@@ -0,0 +1,77 @@
+// c++ -O2 -std=c++98 mains/bench/bench_map_set_ops.cpp -o bench_set_ops && ./bench_set_ops [count]
+#include <iostream>
+#include <iomanip>
+#include <stdlib.h>
+
+#include "../../containers/map.hpp"
+#include "timer.hpp"
+
+typedef ft::map<int, int> map_type;
+
+static void fill(map_type& m, int count, int step) {
+	for (int i = 0; i < count; i++)
+		m.insert(ft::make_pair(i * step, i));
+}
+
+static void print(const char *name, double elementwise, double bulk, size_t size) {
+	std::cout << std::left << std::setw(14) << name
+		<< "element by element: " << std::setw(10) << elementwise << " ms   "
+		<< "bulk: " << std::setw(10) << bulk << " ms   "
+		<< "(size " << size << ")" << std::endl;
+}
+
+int main(int argc, char **argv) {
+	int count = (argc > 1) ? atoi(argv[1]) : 1000000;
+	map_type a, b;
+	fill(a, count, 2);
+	fill(b, count, 3);
+	std::cout << "ft::map set operations, " << count << " elements per map" << std::endl;
+
+	{	// Union
+		bench::timer t;
+		map_type slow(a);
+		for (map_type::iterator it = b.begin(); it != b.end(); it++)
+			slow.insert(*it);
+		double elementwise = t.elapsed_ms();
+		t.reset();
+		map_type fast = ft::set_union(a, b);
+		print("union", elementwise, t.elapsed_ms(), fast.size());
+	}
+	{	// Intersection
+		bench::timer t;
+		map_type slow;
+		for (map_type::iterator it = a.begin(); it != a.end(); it++)
+			if (b.count(it->first))
+				slow.insert(*it);
+		double elementwise = t.elapsed_ms();
+		t.reset();
+		map_type fast = ft::set_intersection(a, b);
+		print("intersection", elementwise, t.elapsed_ms(), fast.size());
+	}
+	{	// Difference
+		bench::timer t;
+		map_type slow(a);
+		for (map_type::iterator it = b.begin(); it != b.end(); it++)
+			slow.erase(it->first);
+		double elementwise = t.elapsed_ms();
+		t.reset();
+		map_type fast = ft::set_difference(a, b);
+		print("difference", elementwise, t.elapsed_ms(), fast.size());
+	}
+	{	// Merge (copies are made outside of the timed sections)
+		map_type dst(a), src(b);
+		bench::timer t;
+		ft::vector<int> moved;
+		for (map_type::iterator it = src.begin(); it != src.end(); it++)
+			if (dst.insert(*it).second)
+				moved.push_back(it->first);
+		for (ft::vector<int>::iterator it = moved.begin(); it != moved.end(); it++)
+			src.erase(*it);
+		double elementwise = t.elapsed_ms();
+		map_type dst2(a), src2(b);
+		t.reset();
+		dst2.merge(src2);
+		print("merge", elementwise, t.elapsed_ms(), dst2.size());
+	}
+	return 0;
+}
@@ -0,0 +1,95 @@
+// c++ -O2 -std=c++98 mains/bench/bench_map_upsert.cpp -o bench_upsert && ./bench_upsert [count]
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <stdlib.h>
+
+#include "../../containers/map.hpp"
+#include "timer.hpp"
+
+// An aggregation counter: heavy to copy, the copies are counted
+struct Counters
+{
+	static long copies;
+
+	Counters() {
+		for (int i = 0; i < 32; i++)
+			this->values[i] = 0;
+	}
+	explicit Counters(long first) {
+		this->values[0] = first;
+		for (int i = 1; i < 32; i++)
+			this->values[i] = 0;
+	}
+	Counters(const Counters& other) {
+		copies++;
+		for (int i = 0; i < 32; i++)
+			this->values[i] = other.values[i];
+	}
+	Counters& operator=(const Counters& other) {
+		copies++;
+		for (int i = 0; i < 32; i++)
+			this->values[i] = other.values[i];
+		return *this;
+	}
+	long values[32];
+};
+long Counters::copies = 0;
+
+static void report(const std::string& name, double ms, int count) {
+	std::cout << std::left << std::setw(48) << name << std::setw(10) << ms << " ms   "
+		<< double(Counters::copies) / count << " copies/op" << std::endl;
+	Counters::copies = 0;
+}
+
+// Each key is upserted 4 times, from count / 4 distinct keys
+template <class Map>
+void runSubscript(const std::string& name, int count) {
+	Map m;
+	bench::timer t;
+	for (int i = 0; i < count; i++)
+		m[i % (count / 4)].values[i % 32]++;
+	report(name, t.elapsed_ms(), count);
+}
+
+template <class Map>
+void runInsertThenFind(const std::string& name, int count) {
+	Map m;
+	bench::timer t;
+	for (int i = 0; i < count; i++)
+		m.insert(typename Map::value_type(i % (count / 4), Counters())).first->second.values[i % 32]++;
+	report(name, t.elapsed_ms(), count);
+}
+
+void runTryEmplace(int count) {
+	ft::map<int, Counters> m;
+	bench::timer t;
+	for (int i = 0; i < count; i++)
+		m.try_emplace(i % (count / 4)).first->second.values[i % 32]++;
+	report("ft::map try_emplace(k)", t.elapsed_ms(), count);
+	ft::map<int, Counters> m2;
+	t.reset();
+	for (int i = 0; i < count; i++)
+		m2.try_emplace(i % (count / 4), long(i)).first->second.values[i % 32]++;
+	report("ft::map try_emplace(k, first)", t.elapsed_ms(), count);
+}
+
+void runInsertOrAssign(int count) {
+	ft::map<int, Counters> m;
+	Counters value(1);
+	bench::timer t;
+	for (int i = 0; i < count; i++)
+		m.insert_or_assign(i % (count / 4), value);
+	report("ft::map insert_or_assign(k, value)", t.elapsed_ms(), count);
+}
+
+int main(int argc, char **argv) {
+	int count = (argc > 1) ? atoi(argv[1]) : 1000000;
+	std::cout << count << " upserts of " << sizeof(Counters) << " byte values, " << count / 4 << " keys" << std::endl;
+	runSubscript<ft::map<int, Counters> >("ft::map operator[]", count);
+	runSubscript<std::map<int, Counters> >("std::map operator[]", count);
+	runInsertThenFind<ft::map<int, Counters> >("ft::map insert(value_type(k, Counters()))", count);
+	runTryEmplace(count);
+	runInsertOrAssign(count);
+	return 0;
+}
@@ -0,0 +1,83 @@
+// c++ -O2 -std=c++98 mains/bench/bench_persistent_map.cpp -o bench_persistent && ./bench_persistent [entries] [versions]
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <functional>
+#include <stdlib.h>
+
+#include "../../containers/map.hpp"
+#include "../../containers/persistent_map.hpp"
+#include "../../utils/instrumented_allocator.hpp"
+#include "timer.hpp"
+
+typedef ft::instrumented_allocator<ft::pair<const int, int> >	counted;
+typedef ft::map<int, int, std::less<int>, counted>				copied_map;
+typedef ft::persistent_map<int, int, std::less<int>, counted>	shared_map;
+
+static void header() {
+	std::cout << std::left << std::setw(16) << "map" << std::right << std::setw(10) << "versions"
+		<< std::setw(10) << "build ms" << std::setw(14) << "us/version" << std::setw(14) << "KB/version"
+		<< std::setw(12) << "total MB" << std::setw(12) << "old ns/at" << std::setw(12) << "new ns/at" << std::endl;
+}
+
+template <class Map>
+double reads(const Map& m, int entries, long& checksum) {
+	unsigned int key = 7;
+	bench::timer t;
+	for (int i = 0; i < 1000000; i++) {
+		key = key * 1103515245 + 12345;
+		checksum += m.at(static_cast<int>((key >> 8) % entries));
+	}
+	return t.elapsed_ms();
+}
+
+// A configuration map of entries keys: each version is kept, then the
+// current map gets one update. Both maps count their nodes in the same way
+template <class Map>
+void run(const std::string& name, int entries, int versions) {
+	ft::allocation_stats stats;
+	long checksum = 0;
+	{
+		bench::timer t;
+		Map current(std::less<int>(), stats);
+		for (int i = 0; i < entries; i++)
+			current.insert_or_assign(i, i);
+		double build = t.elapsed_ms();
+		size_t built = stats.liveBytes;
+
+		std::vector<Map> history;
+		history.reserve(versions);
+		unsigned int key = 42;
+		t.reset();
+		for (int v = 0; v < versions; v++) {
+			history.push_back(current);
+			key = key * 1103515245 + 12345;
+			current.insert_or_assign(static_cast<int>((key >> 8) % entries), -v);
+		}
+		double ms = t.elapsed_ms();
+		size_t added = stats.liveBytes - built;
+
+		double oldReads = reads(history.front(), entries, checksum);
+		double newReads = reads(current, entries, checksum);
+		std::cout << std::left << std::setw(16) << name << std::right << std::setw(10) << versions
+			<< std::fixed << std::setprecision(1) << std::setw(10) << build
+			<< std::setprecision(2) << std::setw(14) << ms * 1000.0 / versions
+			<< std::setw(14) << added / 1024.0 / versions
+			<< std::setw(12) << stats.liveBytes / 1048576.0
+			<< std::setw(12) << oldReads << std::setw(12) << newReads
+			<< "  (checksum " << checksum % 1000 << ")" << std::endl;
+	}
+}
+
+// The copies of ft::map are O(n): a few versions are enough to measure them
+int main(int argc, char **argv) {
+	int entries = (argc > 1) ? atoi(argv[1]) : 1000000;
+	int versions = (argc > 2) ? atoi(argv[2]) : 5000;
+	std::cout << entries << " entries, one update per version, ns/at for 1M random reads" << std::endl;
+	header();
+	run<copied_map>("ft::map copy", entries, std::min(versions, 16));
+	run<shared_map>("persistent_map", entries, std::min(versions, 16));
+	run<shared_map>("persistent_map", entries, versions);
+	return 0;
+}
@@ -0,0 +1,53 @@
+// c++ -O2 -std=c++98 mains/bench/bench_stack_buffers.cpp -o bench_stack && ./bench_stack [count]
+#include <iostream>
+#include <iomanip>
+#include <stack>
+#include <stdlib.h>
+
+#include "../../containers/stack.hpp"
+#include "../../containers/deque.hpp"
+#include "timer.hpp"
+
+#define BUFFER_SIZE 4096
+
+struct Buffer
+{
+	int idx;
+	char buff[BUFFER_SIZE];
+};
+
+// Pushes count buffers then pops them all, as mains/subject.cpp does
+template <class Stack>
+void run(const std::string& name, int count) {
+	Buffer buffer;
+	buffer.idx = 0;
+	long checksum = 0;
+	bench::timer t;
+	{
+		Stack s;
+		for (int i = 0; i < count; i++) {
+			buffer.idx = i;
+			s.push(buffer);
+		}
+		double push = t.elapsed_ms();
+		t.reset();
+		while (!s.empty()) {
+			checksum += s.top().idx;
+			s.pop();
+		}
+		std::cout << std::left << std::setw(36) << name << "push " << std::setw(10) << push
+			<< " ms   pop " << std::setw(10) << t.elapsed_ms() << " ms";
+		t.reset();
+	}
+	std::cout << "   destroy " << std::setw(10) << t.elapsed_ms() << " ms  (checksum "
+		<< checksum << ")" << std::endl;
+}
+
+int main(int argc, char **argv) {
+	int count = (argc > 1) ? atoi(argv[1]) : 250000;
+	std::cout << count << " buffers of " << sizeof(Buffer) << " bytes" << std::endl;
+	run<ft::stack<Buffer> >("ft::stack<Buffer> (ft::vector)", count);
+	run<ft::stack<Buffer, ft::deque<Buffer> > >("ft::stack<Buffer, ft::deque>", count);
+	run<std::stack<Buffer> >("std::stack<Buffer> (std::deque)", count);
+	return 0;
+}
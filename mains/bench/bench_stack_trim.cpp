@@ -0,0 +1,70 @@
+// c++ -O2 -std=c++98 mains/bench/bench_stack_trim.cpp -o bench_trim && ./bench_trim [requests]
+#include <iostream>
+#include <iomanip>
+#include <stack>
+#include <stdlib.h>
+#include <new>
+
+#include "../../containers/stack.hpp"
+#include "../../containers/deque.hpp"
+#include "timer.hpp"
+
+static std::size_t liveBytes = 0;
+static std::size_t peakBytes = 0;
+
+// Tracks the bytes held by the stacks, the size is stored before the block
+__attribute__((noinline)) void *operator new(std::size_t size) throw(std::bad_alloc) {
+	std::size_t *p = static_cast<std::size_t*>(malloc(size + sizeof(std::size_t) * 2));
+	if (!p)
+		throw std::bad_alloc();
+	*p = size;
+	liveBytes += size;
+	if (liveBytes > peakBytes)
+		peakBytes = liveBytes;
+	return p + 2;
+}
+__attribute__((noinline)) void operator delete(void *ptr) throw() {
+	if (!ptr)
+		return ;
+	std::size_t *p = static_cast<std::size_t*>(ptr) - 2;
+	liveBytes -= *p;
+	free(p);
+}
+
+// A parser stack: most requests are a few levels deep, one in 64 nests
+// 200k levels; the bytes held between two requests are sampled
+template <class Stack>
+void run(const std::string& name, int requests) {
+	srand(42);
+	std::size_t before = liveBytes;
+	std::size_t held = 0;
+	long checksum = 0;
+	peakBytes = liveBytes;
+	bench::timer t;
+	{
+		Stack s;
+		for (int r = 0; r < requests; r++) {
+			int depth = (r % 64 == 63) ? 200000 : 1 + rand() % 32;
+			for (int i = 0; i < depth; i++)
+				s.push(i);
+			while (s.size() > 1) {
+				checksum += s.top();
+				s.pop();
+			}
+			held += liveBytes - before;
+		}
+	}
+	std::cout << std::left << std::setw(44) << name << std::setw(10) << t.elapsed_ms() << " ms   held "
+		<< std::setw(10) << held / requests / 1024 << " KB/request   peak "
+		<< (peakBytes - before) / 1024 << " KB  (checksum " << checksum << ")" << std::endl;
+}
+
+int main(int argc, char **argv) {
+	int requests = (argc > 1) ? atoi(argv[1]) : 4096;
+	run<ft::stack<int> >("ft::stack<int> (no_trim)", requests);
+	run<ft::stack<int, ft::vector<int>, ft::high_water_trim<> > >("ft::stack<int> (high_water_trim)", requests);
+	run<ft::stack<int, ft::deque<int> > >("ft::stack<int, ft::deque> (no_trim)", requests);
+	run<ft::stack<int, ft::deque<int>, ft::high_water_trim<> > >("ft::stack<int, ft::deque> (high_water_trim)", requests);
+	run<std::stack<int> >("std::stack<int> (std::deque)", requests);
+	return 0;
+}
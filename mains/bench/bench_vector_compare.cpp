@@ -0,0 +1,76 @@
+// c++ -O2 -std=c++98 mains/bench/bench_vector_compare.cpp -o bench_compare && ./bench_compare [count]
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <stdlib.h>
+
+#include "../../containers/vector.hpp"
+#include "timer.hpp"
+
+// Element by element, as operator== and operator< were written before
+template <class Vector>
+bool loopEqual(const Vector& lhs, const Vector& rhs) {
+	if (lhs.size() != rhs.size())
+		return false;
+	for (typename Vector::size_type i = 0; i < lhs.size(); i++)
+		if (lhs[i] != rhs[i])
+			return false;
+	return true;
+}
+template <class Vector>
+bool loopLess(const Vector& lhs, const Vector& rhs) {
+	return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+// Equal buffers but for the last element, so everything is scanned
+template <class T>
+void run(const std::string& name, int count, int rounds) {
+	ft::vector<T> a(count, T(1)), b(a);
+	std::vector<T> sa(count, T(1)), sb(sa);
+	b[count - 1] = T(2);
+	sb[count - 1] = T(2);
+	int checksum = 0;
+
+	bench::timer t;
+	for (int r = 0; r < rounds; r++)
+		checksum += loopEqual(a, b);
+	double loopEq = t.elapsed_ms();
+	t.reset();
+	for (int r = 0; r < rounds; r++)
+		checksum += (a == b);
+	double ftEq = t.elapsed_ms();
+	t.reset();
+	for (int r = 0; r < rounds; r++)
+		checksum += (sa == sb);
+	double stdEq = t.elapsed_ms();
+
+	t.reset();
+	for (int r = 0; r < rounds; r++)
+		checksum += loopLess(a, b);
+	double loopLt = t.elapsed_ms();
+	t.reset();
+	for (int r = 0; r < rounds; r++)
+		checksum += (a < b);
+	double ftLt = t.elapsed_ms();
+	t.reset();
+	for (int r = 0; r < rounds; r++)
+		checksum += (sa < sb);
+	double stdLt = t.elapsed_ms();
+
+	std::cout << std::left << std::setw(16) << name
+		<< "==  loop " << std::setw(10) << loopEq << " ft " << std::setw(10) << ftEq
+		<< " std " << std::setw(10) << stdEq << " ms" << std::endl;
+	std::cout << std::left << std::setw(16) << ""
+		<< "<   loop " << std::setw(10) << loopLt << " ft " << std::setw(10) << ftLt
+		<< " std " << std::setw(10) << stdLt << " ms  (checksum " << checksum << ")" << std::endl;
+}
+
+int main(int argc, char **argv) {
+	int count = (argc > 1) ? atoi(argv[1]) : 16 * 1024 * 1024;
+	int rounds = 20;
+	std::cout << count << " elements, " << rounds << " rounds" << std::endl;
+	run<int>("vector<int>", count, rounds);
+	run<char>("vector<char>", count, rounds);
+	run<unsigned char>("vector<uchar>", count, rounds);
+	return 0;
+}
@@ -0,0 +1,83 @@
+// c++ -O2 -std=c++98 mains/bench/bench_vector_unwrap.cpp -o bench_unwrap && ./bench_unwrap [count]
+// Vectorized loops: add -fopt-info-vec-optimized -ftree-vectorize (the vector.hpp lines are reported)
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <stdlib.h>
+
+#include "../../containers/vector.hpp"
+#include "timer.hpp"
+
+static void report(const std::string& what, double ft_ms, double std_ms) {
+	std::cout << std::left << std::setw(24) << what << "ft " << std::setw(10) << ft_ms
+		<< " ms   std " << std::setw(10) << std_ms << " ms" << std::endl;
+}
+
+// The same operations on ft::vector<int> and std::vector<int>
+template <class Vector>
+struct runner
+{
+	Vector src;
+	double copy, assign, erase, insert, equal, less;
+	int checksum;
+
+	runner(int count) : src(), checksum(0) {
+		for (int i = 0; i < count; i++)
+			this->src.push_back(i);
+	}
+	void run(int rounds) {
+		bench::timer t;
+		for (int r = 0; r < rounds; r++) {
+			Vector v(this->src);
+			this->checksum += v[r % v.size()];
+		}
+		this->copy = t.elapsed_ms();
+		Vector v;
+		t.reset();
+		for (int r = 0; r < rounds; r++) {
+			v.assign(this->src.begin(), this->src.end());
+			this->checksum += v[r % v.size()];
+		}
+		this->assign = t.elapsed_ms();
+		t.reset();
+		for (int r = 0; r < rounds; r++) {
+			v.erase(v.begin(), v.begin() + 1);
+			this->checksum += v[0];
+		}
+		this->erase = t.elapsed_ms();
+		t.reset();
+		for (int r = 0; r < rounds; r++) {
+			v.insert(v.begin(), this->src.begin(), this->src.begin() + 1);
+			this->checksum += v[0];
+		}
+		this->insert = t.elapsed_ms();
+		Vector w(v);	// Equal, so the comparisons scan everything
+		t.reset();
+		for (int r = 0; r < rounds; r++)
+			this->checksum += (v == w);
+		this->equal = t.elapsed_ms();
+		t.reset();
+		for (int r = 0; r < rounds; r++)
+			this->checksum += (v < w);
+		this->less = t.elapsed_ms();
+	}
+};
+
+int main(int argc, char **argv) {
+	int count = (argc > 1) ? atoi(argv[1]) : 1000000;
+	int rounds = 100;
+	runner<ft::vector<int> > mine(count);
+	runner<std::vector<int> > real(count);
+	mine.run(rounds);
+	real.run(rounds);
+	std::cout << "vector<int> of " << count << " elements, " << rounds << " rounds" << std::endl;
+	report("copy constructor", mine.copy, real.copy);
+	report("assign(first, last)", mine.assign, real.assign);
+	report("erase(front)", mine.erase, real.erase);
+	report("insert(front, range)", mine.insert, real.insert);
+	report("operator==", mine.equal, real.equal);
+	report("operator<", mine.less, real.less);
+	if (mine.checksum != real.checksum)
+		std::cout << "checksum mismatch: " << mine.checksum << " " << real.checksum << std::endl;
+	return 0;
+}
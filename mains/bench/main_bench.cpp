@@ -0,0 +1,375 @@
+// make bench [BENCH_ARGS="--size 100000 --reps 31 --warmup 3 --filter map. --format csv"]
+// make bench BENCH_ARGS="--sweep 1000:100000000:10 --max-mb 2048 --reps 5"
+// make bench BENCH_ARGS="--report allocs --size 10000"
+// make bench BENCH_ARGS="--report counters --filter map.find"
+#include <vector>
+#include <map>
+#include <deque>
+#include <stack>
+#include <string>
+#include <new>
+#include <stdlib.h>
+#include <malloc.h>
+
+#include "../../containers/vector.hpp"
+#include "../../containers/map.hpp"
+#include "../../containers/deque.hpp"
+#include "../../containers/stack.hpp"
+#include "bench.hpp"
+
+// The bytes really taken from malloc are counted for the footprints
+void *operator new(std::size_t size) throw(std::bad_alloc) {
+	void *p = malloc(size ? size : 1);
+	if (!p)
+		throw std::bad_alloc();
+	bench::live_bytes() += malloc_usable_size(p);
+	return p;
+}
+void operator delete(void *p) throw() {
+	if (!p)
+		return ;
+	bench::live_bytes() -= malloc_usable_size(p);
+	free(p);
+}
+
+// The 4KB buffer of mains/subject.cpp
+struct Buffer
+{
+	int idx;
+	char buff[4096];
+};
+
+// Element i of a container, and a value read from it
+template <class T>
+T element(std::size_t i);
+template <>
+int element<int>(std::size_t i) {
+	return static_cast<int>(i);
+}
+template <>
+std::string element<std::string>(std::size_t i) {	// Past the small string buffer
+	std::string s(24, 'x');
+	s[0] = char('a' + i % 26);
+	return s;
+}
+template <>
+Buffer element<Buffer>(std::size_t i) {
+	Buffer b;
+	b.idx = static_cast<int>(i);
+	b.buff[0] = 0;
+	return b;
+}
+static long value(int i) {
+	return i;
+}
+static long value(const std::string& s) {
+	return s[0];
+}
+static long value(const Buffer& b) {
+	return b.idx;
+}
+
+// The same pseudo random keys for every case of a size, built outside the timings
+static const std::vector<int>& keys(std::size_t n) {
+	static std::vector<int> k;
+	if (k.size() != n) {
+		k.resize(n);
+		for (std::size_t i = 0; i < n; i++)
+			k[i] = static_cast<int>(i);
+		unsigned long seed = 42;
+		for (std::size_t i = n; i > 1; i--) {
+			seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+			std::swap(k[i - 1], k[(seed >> 33) % i]);
+		}
+	}
+	return k;
+}
+
+template <class Sequence>
+static void fill(Sequence& s, std::size_t n) {
+	for (std::size_t i = 0; i < n; i++)
+		s.push_back(element<typename Sequence::value_type>(i));
+	bench::footprint(s.size());
+}
+
+// The shape of the AVL tree of ft::map next to its timings, debug builds
+// only: an O(n) walk, always taken out of the timed region
+template <class Map>
+static void noteShape(const Map&) {}
+template <class K, class V, class C, class A>
+static void noteShape(const ft::map<K, V, C, A>& m) {
+#ifndef NDEBUG
+	typename ft::map<K, V, C, A>::shape_stats s = m.shape();
+	std::ostringstream out;
+	out << "height " << s.height << " (min " << s.minHeight << "), depth avg " << std::fixed
+		<< std::setprecision(2) << s.averageDepth << " max " << s.maxDepth;
+	bench::note(out.str());
+#else
+	(void)m;
+#endif
+}
+
+template <class Map>
+static void fill(Map& m, const std::vector<int>& k) {
+	for (std::size_t i = 0; i < k.size(); i++)
+		m.insert(typename Map::value_type(k[i], element<typename Map::mapped_type>(k[i])));
+	bench::footprint(m.size());
+}
+
+							/*   Sequences   */
+
+template <class Sequence>
+double pushBack(std::size_t n) {
+	bench::timer t;
+	Sequence s;
+	fill(s, n);
+	bench::keep(s.size());
+	return bench::stop(t);
+}
+
+template <class Sequence>
+double pushFront(std::size_t n) {
+	bench::timer t;
+	Sequence s;
+	for (std::size_t i = 0; i < n; i++)
+		s.push_front(element<typename Sequence::value_type>(i));
+	bench::footprint(s.size());
+	bench::keep(s.size());
+	return bench::stop(t);
+}
+
+// In the middle of 1024 elements, each insert is undone by a pop_back
+template <class Sequence>
+double insertMiddle(std::size_t n) {
+	Sequence s;
+	fill(s, 1024);
+	bench::start();
+	bench::timer t;
+	for (std::size_t i = 0; i < n; i++) {
+		s.insert(s.begin() + 512, element<typename Sequence::value_type>(i));
+		s.pop_back();
+	}
+	double ms = bench::stop(t);
+	bench::keep(value(s[512]));
+	return ms;
+}
+
+// In the middle of 1024 elements, each erase is undone by a push_back
+template <class Sequence>
+double eraseMiddle(std::size_t n) {
+	Sequence s;
+	fill(s, 1024);
+	bench::start();
+	bench::timer t;
+	for (std::size_t i = 0; i < n; i++) {
+		s.erase(s.begin() + 512);
+		s.push_back(element<typename Sequence::value_type>(i));
+	}
+	double ms = bench::stop(t);
+	bench::keep(value(s[512]));
+	return ms;
+}
+
+template <class Container>
+double iterate(std::size_t n) {
+	Container c;
+	fill(c, n);
+	bench::start();
+	bench::timer t;
+	long sum = 0;
+	for (typename Container::const_iterator it = c.begin(); it != c.end(); it++)
+		sum += value(*it);
+	double ms = bench::stop(t);
+	bench::keep(sum);
+	return ms;
+}
+
+template <class Container>
+double copy(std::size_t n) {
+	Container c;
+	fill(c, n);
+	bench::start();
+	bench::timer t;
+	{
+		Container copy(c);
+		bench::keep(copy.size());
+	}
+	return bench::stop(t);
+}
+
+							/*   Maps   */
+
+template <class Map>
+double mapInsert(std::size_t n) {
+	const std::vector<int>& k = keys(n);
+	bench::timer t;
+	Map m;
+	fill(m, k);
+	bench::keep(m.size());
+	double ms = bench::stop(t);
+	noteShape(m);
+	return ms;
+}
+
+template <class Map>
+double mapFind(std::size_t n) {
+	const std::vector<int>& k = keys(n);
+	Map m;
+	fill(m, k);
+	noteShape(m);
+	bench::start();
+	bench::timer t;
+	long found = 0;
+	for (std::size_t i = 0; i < n; i++)
+		found += value(m.find(static_cast<int>(i))->second);
+	double ms = bench::stop(t);
+	bench::keep(found);
+	return ms;
+}
+
+template <class Map>
+double mapErase(std::size_t n) {
+	const std::vector<int>& k = keys(n);
+	Map m;
+	fill(m, k);
+	noteShape(m);
+	bench::start();
+	bench::timer t;
+	for (std::size_t i = 0; i < n; i++)
+		m.erase(static_cast<int>(i));
+	double ms = bench::stop(t);
+	bench::keep(m.size());
+	return ms;
+}
+
+template <class Map>
+double mapIterate(std::size_t n) {
+	Map m;
+	fill(m, keys(n));
+	noteShape(m);
+	bench::start();
+	bench::timer t;
+	long sum = 0;
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); it++)
+		sum += value(it->second);
+	double ms = bench::stop(t);
+	bench::keep(sum);
+	return ms;
+}
+
+template <class Map>
+double mapCopy(std::size_t n) {
+	Map m;
+	fill(m, keys(n));
+	noteShape(m);
+	bench::start();
+	bench::timer t;
+	{
+		Map copy(m);
+		bench::keep(copy.size());
+	}
+	return bench::stop(t);
+}
+
+							/*   Stack   */
+
+template <class Stack>
+double stackPushPop(std::size_t n) {
+	bench::timer t;
+	Stack s;
+	for (std::size_t i = 0; i < n; i++)
+		s.push(element<typename Stack::value_type>(i));
+	bench::footprint(s.size());
+	long sum = 0;
+	while (!s.empty()) {
+		sum += value(s.top());
+		s.pop();
+	}
+	bench::keep(sum);
+	return bench::stop(t);
+}
+
+// The containers of the cases, with std::allocator and with the
+// instrumented allocator of --report allocs
+template <class T>
+struct containers {
+	typedef ft::instrumented_allocator<T>							counted;
+	typedef ft::instrumented_allocator<ft::pair<const int, T> >		ft_counted_pair;
+	typedef ft::instrumented_allocator<std::pair<const int, T> >	std_counted_pair;
+
+	typedef ft::vector<T>											ft_vector;
+	typedef std::vector<T>											std_vector;
+	typedef ft::vector<T, counted>									ft_vector_counted;
+	typedef std::vector<T, counted>									std_vector_counted;
+	typedef ft::deque<T>											ft_deque;
+	typedef std::deque<T>											std_deque;
+	typedef ft::deque<T, counted>									ft_deque_counted;
+	typedef std::deque<T, counted>									std_deque_counted;
+	typedef ft::map<int, T>											ft_map;
+	typedef std::map<int, T>										std_map;
+	typedef ft::map<int, T, std::less<int>, ft_counted_pair>		ft_map_counted;
+	typedef std::map<int, T, std::less<int>, std_counted_pair>		std_map_counted;
+	typedef ft::stack<T>											ft_stack;
+	typedef std::stack<T>											std_stack;
+	typedef ft::stack<T, ft_vector_counted>							ft_stack_counted;
+	typedef std::stack<T, std_deque_counted>						std_stack_counted;
+};
+
+// The operations whose cost depends on the number and the size of the elements
+template <class T>
+void addScaling(bench::suite& s, const std::string& name) {
+	typedef containers<T>	c;
+	s.add("vector", "push_back", name, sizeof(T), "ft", pushBack<typename c::ft_vector>,
+		pushBack<typename c::ft_vector_counted>);
+	s.add("vector", "push_back", name, sizeof(T), "std", pushBack<typename c::std_vector>,
+		pushBack<typename c::std_vector_counted>);
+	s.add("vector", "iterate", name, sizeof(T), "ft", iterate<typename c::ft_vector>,
+		iterate<typename c::ft_vector_counted>);
+	s.add("vector", "iterate", name, sizeof(T), "std", iterate<typename c::std_vector>,
+		iterate<typename c::std_vector_counted>);
+	s.add("map", "insert", name, sizeof(T), "ft", mapInsert<typename c::ft_map>,
+		mapInsert<typename c::ft_map_counted>);
+	s.add("map", "insert", name, sizeof(T), "std", mapInsert<typename c::std_map>,
+		mapInsert<typename c::std_map_counted>);
+	s.add("map", "find", name, sizeof(T), "ft", mapFind<typename c::ft_map>,
+		mapFind<typename c::ft_map_counted>);
+	s.add("map", "find", name, sizeof(T), "std", mapFind<typename c::std_map>,
+		mapFind<typename c::std_map_counted>);
+	s.add("stack", "push_pop", name, sizeof(T), "ft", stackPushPop<typename c::ft_stack>,
+		stackPushPop<typename c::ft_stack_counted>);
+	s.add("stack", "push_pop", name, sizeof(T), "std", stackPushPop<typename c::std_stack>,
+		stackPushPop<typename c::std_stack_counted>);
+}
+
+int main(int argc, char **argv) {
+	typedef containers<int>	c;
+
+	bench::suite s;
+	addScaling<int>(s, "int");
+	addScaling<std::string>(s, "string");
+	addScaling<Buffer>(s, "Buffer");
+
+	s.add("vector", "insert_mid_1k", "ft", insertMiddle<c::ft_vector>, insertMiddle<c::ft_vector_counted>);
+	s.add("vector", "insert_mid_1k", "std", insertMiddle<c::std_vector>, insertMiddle<c::std_vector_counted>);
+	s.add("vector", "erase_mid_1k", "ft", eraseMiddle<c::ft_vector>, eraseMiddle<c::ft_vector_counted>);
+	s.add("vector", "erase_mid_1k", "std", eraseMiddle<c::std_vector>, eraseMiddle<c::std_vector_counted>);
+	s.add("vector", "copy", "ft", copy<c::ft_vector>, copy<c::ft_vector_counted>);
+	s.add("vector", "copy", "std", copy<c::std_vector>, copy<c::std_vector_counted>);
+
+	s.add("deque", "push_back", "ft", pushBack<c::ft_deque>, pushBack<c::ft_deque_counted>);
+	s.add("deque", "push_back", "std", pushBack<c::std_deque>, pushBack<c::std_deque_counted>);
+	s.add("deque", "push_front", "ft", pushFront<c::ft_deque>, pushFront<c::ft_deque_counted>);
+	s.add("deque", "push_front", "std", pushFront<c::std_deque>, pushFront<c::std_deque_counted>);
+	s.add("deque", "insert_mid_1k", "ft", insertMiddle<c::ft_deque>, insertMiddle<c::ft_deque_counted>);
+	s.add("deque", "insert_mid_1k", "std", insertMiddle<c::std_deque>, insertMiddle<c::std_deque_counted>);
+	s.add("deque", "iterate", "ft", iterate<c::ft_deque>, iterate<c::ft_deque_counted>);
+	s.add("deque", "iterate", "std", iterate<c::std_deque>, iterate<c::std_deque_counted>);
+
+	s.add("map", "erase", "ft", mapErase<c::ft_map>, mapErase<c::ft_map_counted>);
+	s.add("map", "erase", "std", mapErase<c::std_map>, mapErase<c::std_map_counted>);
+	s.add("map", "iterate", "ft", mapIterate<c::ft_map>, mapIterate<c::ft_map_counted>);
+	s.add("map", "iterate", "std", mapIterate<c::std_map>, mapIterate<c::std_map_counted>);
+	s.add("map", "copy", "ft", mapCopy<c::ft_map>, mapCopy<c::ft_map_counted>);
+	s.add("map", "copy", "std", mapCopy<c::std_map>, mapCopy<c::std_map_counted>);
+	return s.run(argc, argv);
+}
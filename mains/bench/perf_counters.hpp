@@ -0,0 +1,116 @@
+#ifndef PERF_COUNTERS_HPP
+# define PERF_COUNTERS_HPP
+
+# include <cstring>
+# include <stdint.h>
+# ifdef __linux__
+#  include <linux/perf_event.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+# endif
+
+namespace bench
+{
+	enum counter_id { CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, COUNTERS };
+
+	inline const char *counter_name(int id) {
+		static const char *names[COUNTERS] = { "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses" };
+		return names[id];
+	}
+
+	// Raw values of the counters at one point; time enabled and running
+	// scale the counts when the kernel multiplexes more events than the PMU has
+	struct counter_sample {
+		uint64_t	value[COUNTERS];
+		uint64_t	enabled[COUNTERS];
+		uint64_t	running[COUNTERS];
+	};
+
+	// Counts of the user space of this thread between two samples, a counter
+	// that could not be opened (no PMU in a VM, perf_event_paranoid, not
+	// Linux) is not valid and the others still work
+	struct counter_values {
+		double	count[COUNTERS];
+		bool	valid[COUNTERS];
+	};
+
+	// The hardware counters of perf_event_open, opened once and left
+	// running, the measures are differences of two reads
+	class perf_counters
+	{
+	public:
+		perf_counters() : opened(0) {
+			for (int i = 0; i < COUNTERS; i++)
+				this->fd[i] = -1;
+# ifdef __linux__
+			this->fd[CYCLES] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+			this->fd[INSTRUCTIONS] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+			this->fd[L1D_MISSES] = open(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+				| (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+			this->fd[LLC_MISSES] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+			this->fd[BRANCH_MISSES] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+			for (int i = 0; i < COUNTERS; i++)
+				this->opened += (this->fd[i] >= 0);
+# endif
+		}
+		~perf_counters() {
+# ifdef __linux__
+			for (int i = 0; i < COUNTERS; i++)
+				if (this->fd[i] >= 0)
+					close(this->fd[i]);
+# endif
+		}
+
+		bool available() const {
+			return this->opened > 0;
+		}
+
+		void sample(counter_sample& s) const {
+			std::memset(&s, 0, sizeof(s));
+# ifdef __linux__
+			for (int i = 0; i < COUNTERS; i++) {
+				uint64_t buf[3];
+				if (this->fd[i] >= 0 && read(this->fd[i], buf, sizeof(buf)) == sizeof(buf)) {
+					s.value[i] = buf[0];
+					s.enabled[i] = buf[1];
+					s.running[i] = buf[2];
+				}
+			}
+# endif
+		}
+
+		counter_values delta(const counter_sample& from, const counter_sample& to) const {
+			counter_values d;
+			for (int i = 0; i < COUNTERS; i++) {
+				uint64_t running = to.running[i] - from.running[i];
+				d.valid[i] = this->fd[i] >= 0 && running > 0;
+				d.count[i] = d.valid[i] ? double(to.value[i] - from.value[i])
+					* double(to.enabled[i] - from.enabled[i]) / running : 0;
+			}
+			return d;
+		}
+
+	private:
+		int	fd[COUNTERS];
+		int	opened;
+
+		perf_counters(const perf_counters&);
+		perf_counters& operator=(const perf_counters&);
+
+# ifdef __linux__
+		static int open(uint32_t type, uint64_t config) {
+			struct perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = type;
+			attr.config = config;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+		}
+# endif
+	};
+}
+
+#endif // PERF_COUNTERS_HPP
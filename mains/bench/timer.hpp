@@ -0,0 +1,30 @@
+#ifndef TIMER_HPP
+# define TIMER_HPP
+
+# include <time.h>
+
+namespace bench
+{
+	// Monotonic clock, in milliseconds
+	inline double now_ms() {
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+	}
+
+	class timer
+	{
+	public:
+		timer() : start(now_ms()) {}
+		double elapsed_ms() const {
+			return now_ms() - this->start;
+		}
+		void reset() {
+			this->start = now_ms();
+		}
+	private:
+		double start;
+	};
+}
+
+#endif // TIMER_HPP
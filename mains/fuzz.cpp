@@ -0,0 +1,579 @@
+// make fuzz [FUZZ_ARGS="seed [steps] [full_check_every]"]
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <stack>
+#include <stdexcept>
+#include <stdlib.h>
+
+#include "../containers/vector.hpp"
+#include "../containers/map.hpp"
+#include "../containers/stack.hpp"
+#include "bench/timer.hpp"
+
+// Random operations run on ft:: and std:: side by side: the results of each
+// step and the containers are compared, and every operation is timed
+
+#define MAX_VECTOR 2048
+#define MAX_KEY 4096
+
+// The same sequence on every platform for a seed, unlike rand()
+class generator
+{
+public:
+	explicit generator(unsigned long seed) : state(seed * 2654435761UL + 1) {}
+	unsigned long next() {
+		this->state = this->state * 6364136223846793005UL + 1442695040888963407UL;
+		return this->state >> 33;
+	}
+	int below(std::size_t n) {
+		return n ? static_cast<int>(this->next() % n) : 0;
+	}
+private:
+	unsigned long state;
+};
+
+enum op_id {
+	V_PUSH_BACK, V_POP_BACK, V_INSERT, V_INSERT_FILL, V_INSERT_RANGE, V_ERASE, V_ERASE_RANGE,
+	V_RESIZE, V_ASSIGN, V_AT, V_ITERATE, V_COPY, V_RESERVE, V_CLEAR,
+	M_INSERT, M_INSERT_HINT, M_INSERT_RANGE, M_SUBSCRIPT, M_ERASE_KEY, M_ERASE_IT, M_ERASE_RANGE,
+	M_FIND, M_COUNT, M_BOUNDS, M_EQUAL_RANGE, M_ITERATE, M_COPY, M_CLEAR,
+	S_PUSH, S_POP, S_TOP,
+	OPS
+};
+
+static const char *opNames[OPS] = {
+	"vector.push_back", "vector.pop_back", "vector.insert", "vector.insert_fill", "vector.insert_range",
+	"vector.erase", "vector.erase_range", "vector.resize", "vector.assign", "vector.at", "vector.iterate",
+	"vector.copy", "vector.reserve", "vector.clear",
+	"map.insert", "map.insert_hint", "map.insert_range", "map.operator[]", "map.erase_key", "map.erase_it",
+	"map.erase_range", "map.find", "map.count", "map.bounds", "map.equal_range", "map.iterate", "map.copy",
+	"map.clear",
+	"stack.push", "stack.pop", "stack.top"
+};
+
+// Relative frequencies, the clears only run once in 16 picks so the containers can grow
+static const int opWeights[OPS] = {
+	12, 6, 6, 3, 3, 6, 2, 2, 1, 6, 2, 1, 1, 1,
+	12, 4, 2, 6, 6, 4, 1, 8, 4, 4, 2, 2, 1, 1,
+	6, 5, 3
+};
+
+class driver
+{
+public:
+	driver(unsigned long seed, long checkEvery) : gen(seed), seed(seed), step(0), checkEvery(checkEvery), totalWeight(0) {
+		for (int i = 0; i < OPS; i++) {
+			this->count[i] = 0;
+			this->ms[i][0] = 0;
+			this->ms[i][1] = 0;
+		}
+		for (int i = 0; i < OPS; i++)
+			this->totalWeight += opWeights[i];
+	}
+
+	void run(long steps) {
+		for (this->step = 0; this->step < steps; this->step++) {
+			op_id op = this->pick();
+			this->execute(op);
+			this->checkSizes(op);
+			if (this->checkEvery && this->step % this->checkEvery == 0)
+				this->checkContents(op);
+		}
+		for (int op = 0; op < OPS; op++)
+			this->checkContents(static_cast<op_id>(op));
+	}
+
+	void report() const {
+		std::cout << "seed " << this->seed << ": " << this->step << " steps, ft:: and std:: equivalent, sizes "
+			<< this->fv.size() << " / " << this->fm.size() << " / " << this->fs.size() << std::endl;
+		std::cout << std::left << std::setw(22) << "operation" << std::right << std::setw(10) << "timed"
+			<< std::setw(12) << "ft ns/op" << std::setw(12) << "std ns/op" << std::setw(9) << "ft/std" << std::endl;
+		double total[2] = { 0, 0 };
+		for (int op = 0; op < OPS; op++) {
+			if (!this->count[op])
+				continue;
+			double ftNs = this->ms[op][0] * 1000000.0 / this->count[op];
+			double stdNs = this->ms[op][1] * 1000000.0 / this->count[op];
+			total[0] += this->ms[op][0];
+			total[1] += this->ms[op][1];
+			std::cout << std::left << std::setw(22) << opNames[op] << std::right << std::setw(10) << this->count[op]
+				<< std::fixed << std::setprecision(1) << std::setw(12) << ftNs << std::setw(12) << stdNs
+				<< std::setprecision(2) << std::setw(9) << (stdNs > 0 ? ftNs / stdNs : 0) << std::endl;
+		}
+		std::cout << std::left << std::setw(22) << "total ms" << std::right << std::setw(10) << this->step
+			<< std::fixed << std::setprecision(1) << std::setw(12) << total[0] << std::setw(12) << total[1]
+			<< std::setprecision(2) << std::setw(9) << (total[1] > 0 ? total[0] / total[1] : 0) << std::endl;
+	}
+
+private:
+	typedef ft::vector<int>			ft_vector;
+	typedef std::vector<int>		std_vector;
+	typedef ft::map<int, int>		ft_map;
+	typedef std::map<int, int>		std_map;
+
+	generator		gen;
+	unsigned long	seed;
+	long			step;
+	long			checkEvery;		// Steps between two full comparisons, 0 only at the end
+	int				totalWeight;
+	long			count[OPS];
+	double			ms[OPS][2];		// ft, std
+
+	ft_vector		fv;
+	std_vector		sv;
+	ft_map			fm;
+	std_map			sm;
+	ft::stack<int>	fs;
+	std::stack<int>	ss;
+
+	bench::timer	t;
+
+	op_id pick() {
+		int w = this->gen.below(this->totalWeight);
+		int op = 0;
+		while (w >= opWeights[op])
+			w -= opWeights[op++];
+		return static_cast<op_id>(op);
+	}
+
+	// Between two operations of a step: the ft:: one is timed first
+	void startFt() {
+		this->t.reset();
+	}
+	void startStd(op_id op) {
+		this->ms[op][0] += this->t.elapsed_ms();
+		this->t.reset();
+	}
+	void done(op_id op) {
+		this->ms[op][1] += this->t.elapsed_ms();
+		this->count[op]++;
+	}
+
+	void fail(op_id op, const std::string& what) const {
+		std::cerr << "fuzz: seed " << this->seed << ", step " << this->step << ", " << opNames[op]
+			<< ": " << what << std::endl;
+		exit(1);
+	}
+	void expect(bool ok, op_id op, const std::string& what) const {
+		if (!ok)
+			this->fail(op, what);
+	}
+
+	void execute(op_id op) {
+		if (op <= V_CLEAR)
+			this->vectorOp(op);
+		else if (op <= M_CLEAR)
+			this->mapOp(op);
+		else
+			this->stackOp(op);
+	}
+
+							/*   Vector   */
+
+	void vectorOp(op_id op) {
+		std::size_t size = this->sv.size();
+		int value = this->gen.below(1000000);
+		std::size_t pos = this->gen.below(size + 1);
+		std::size_t n = 1 + this->gen.below(16);
+		if (size >= MAX_VECTOR && op <= V_INSERT_RANGE && op != V_POP_BACK)
+			op = V_ERASE_RANGE;
+		switch (op) {
+			case V_PUSH_BACK:
+				this->startFt();
+				this->fv.push_back(value);
+				this->startStd(op);
+				this->sv.push_back(value);
+				this->done(op);
+				break ;
+			case V_POP_BACK:
+				if (!size)
+					break ;
+				this->startFt();
+				this->fv.pop_back();
+				this->startStd(op);
+				this->sv.pop_back();
+				this->done(op);
+				break ;
+			case V_INSERT: {
+				this->startFt();
+				ft_vector::iterator fi = this->fv.insert(this->fv.begin() + pos, value);
+				this->startStd(op);
+				std_vector::iterator si = this->sv.insert(this->sv.begin() + pos, value);
+				this->done(op);
+				this->expect(fi - this->fv.begin() == si - this->sv.begin() && *fi == *si, op, "returned iterator");
+				break ;
+			}
+			case V_INSERT_FILL:
+				this->startFt();
+				this->fv.insert(this->fv.begin() + pos, n, value);
+				this->startStd(op);
+				this->sv.insert(this->sv.begin() + pos, n, value);
+				this->done(op);
+				break ;
+			case V_INSERT_RANGE: {
+				int values[16];
+				for (std::size_t i = 0; i < n; i++)
+					values[i] = this->gen.below(1000000);
+				this->startFt();
+				this->fv.insert(this->fv.begin() + pos, values, values + n);
+				this->startStd(op);
+				this->sv.insert(this->sv.begin() + pos, values, values + n);
+				this->done(op);
+				break ;
+			}
+			case V_ERASE: {
+				if (!size)
+					break ;
+				pos %= size;
+				this->startFt();
+				ft_vector::iterator fi = this->fv.erase(this->fv.begin() + pos);
+				this->startStd(op);
+				std_vector::iterator si = this->sv.erase(this->sv.begin() + pos);
+				this->done(op);
+				this->expect(fi - this->fv.begin() == si - this->sv.begin(), op, "returned iterator");
+				break ;
+			}
+			case V_ERASE_RANGE: {
+				std::size_t first = this->gen.below(size + 1);
+				std::size_t last = first + this->gen.below(size - first + 1);
+				this->startFt();
+				ft_vector::iterator fi = this->fv.erase(this->fv.begin() + first, this->fv.begin() + last);
+				this->startStd(op);
+				std_vector::iterator si = this->sv.erase(this->sv.begin() + first, this->sv.begin() + last);
+				this->done(op);
+				this->expect(fi - this->fv.begin() == si - this->sv.begin(), op, "returned iterator");
+				break ;
+			}
+			case V_RESIZE:
+				n = this->gen.below(MAX_VECTOR);
+				this->startFt();
+				this->fv.resize(n, value);
+				this->startStd(op);
+				this->sv.resize(n, value);
+				this->done(op);
+				break ;
+			case V_ASSIGN:
+				n = this->gen.below(MAX_VECTOR / 4);
+				this->startFt();
+				this->fv.assign(n, value);
+				this->startStd(op);
+				this->sv.assign(n, value);
+				this->done(op);
+				break ;
+			case V_AT: {
+				std::size_t i = this->gen.below(size + 2);	// Out of range too
+				bool ftThrew = false;
+				bool stdThrew = false;
+				int ftValue = 0;
+				int stdValue = 0;
+				this->startFt();
+				try { ftValue = this->fv.at(i); } catch (const std::out_of_range&) { ftThrew = true; }
+				this->startStd(op);
+				try { stdValue = this->sv.at(i); } catch (const std::out_of_range&) { stdThrew = true; }
+				this->done(op);
+				this->expect(ftThrew == stdThrew && ftValue == stdValue, op, "value or exception");
+				break ;
+			}
+			case V_ITERATE: {
+				long ftSum = 0;
+				long stdSum = 0;
+				this->startFt();
+				for (ft_vector::const_iterator it = this->fv.begin(); it != this->fv.end(); it++)
+					ftSum += *it;
+				for (ft_vector::reverse_iterator it = this->fv.rbegin(); it != this->fv.rend(); it++)
+					ftSum -= *it / 2;
+				this->startStd(op);
+				for (std_vector::const_iterator it = this->sv.begin(); it != this->sv.end(); it++)
+					stdSum += *it;
+				for (std_vector::reverse_iterator it = this->sv.rbegin(); it != this->sv.rend(); it++)
+					stdSum -= *it / 2;
+				this->done(op);
+				this->expect(ftSum == stdSum, op, "sums");
+				break ;
+			}
+			case V_COPY: {
+				this->startFt();
+				ft_vector fc(this->fv);
+				this->fv = fc;
+				this->startStd(op);
+				std_vector sc(this->sv);
+				this->sv = sc;
+				this->done(op);
+				break ;
+			}
+			case V_RESERVE:
+				n = this->gen.below(MAX_VECTOR * 2);
+				this->startFt();
+				this->fv.reserve(n);
+				this->startStd(op);
+				this->sv.reserve(n);
+				this->done(op);
+				this->expect(this->fv.capacity() >= n, op, "capacity");
+				break ;
+			case V_CLEAR:
+				if (this->gen.below(16))
+					break ;
+				this->startFt();
+				this->fv.clear();
+				this->startStd(op);
+				this->sv.clear();
+				this->done(op);
+				break ;
+			default:
+				break ;
+		}
+	}
+
+							/*   Map   */
+
+	template <class FtIt, class StdIt>
+	void sameIterator(op_id op, FtIt fi, FtIt fend, StdIt si, StdIt send, const char *what) const {
+		bool ftEnd = (fi == fend);
+		this->expect(ftEnd == (si == send), op, what);
+		if (!ftEnd)
+			this->expect(fi->first == si->first && fi->second == si->second, op, what);
+	}
+
+	void mapOp(op_id op) {
+		int key = this->gen.below(MAX_KEY);
+		int value = this->gen.below(1000000);
+		switch (op) {
+			case M_INSERT: {
+				this->startFt();
+				ft::pair<ft_map::iterator, bool> fr = this->fm.insert(ft::make_pair(key, value));
+				this->startStd(op);
+				std::pair<std_map::iterator, bool> sr = this->sm.insert(std::make_pair(key, value));
+				this->done(op);
+				this->expect(fr.second == sr.second, op, "inserted");
+				this->sameIterator(op, fr.first, this->fm.end(), sr.first, this->sm.end(), "returned iterator");
+				break ;
+			}
+			case M_INSERT_HINT: {
+				this->startFt();
+				ft_map::iterator fi = this->fm.insert(this->fm.lower_bound(key), ft::make_pair(key, value));
+				this->startStd(op);
+				std_map::iterator si = this->sm.insert(this->sm.lower_bound(key), std::make_pair(key, value));
+				this->done(op);
+				this->sameIterator(op, fi, this->fm.end(), si, this->sm.end(), "returned iterator");
+				break ;
+			}
+			case M_INSERT_RANGE: {
+				ft::pair<int, int> ftValues[16];
+				std::pair<int, int> stdValues[16];
+				std::size_t n = 1 + this->gen.below(16);
+				for (std::size_t i = 0; i < n; i++) {
+					ftValues[i] = ft::make_pair(this->gen.below(MAX_KEY), value + static_cast<int>(i));
+					stdValues[i] = std::make_pair(ftValues[i].first, ftValues[i].second);
+				}
+				this->startFt();
+				this->fm.insert(ftValues, ftValues + n);
+				this->startStd(op);
+				this->sm.insert(stdValues, stdValues + n);
+				this->done(op);
+				break ;
+			}
+			case M_SUBSCRIPT: {
+				this->startFt();
+				int& fr = this->fm[key];
+				fr += value;
+				this->startStd(op);
+				int& sr = this->sm[key];
+				sr += value;
+				this->done(op);
+				this->expect(fr == sr, op, "value");
+				break ;
+			}
+			case M_ERASE_KEY: {
+				this->startFt();
+				std::size_t fn = this->fm.erase(key);
+				this->startStd(op);
+				std::size_t sn = this->sm.erase(key);
+				this->done(op);
+				this->expect(fn == sn, op, "erased count");
+				break ;
+			}
+			case M_ERASE_IT: {
+				ft_map::iterator fi = this->fm.find(key);
+				std_map::iterator si = this->sm.find(key);
+				this->sameIterator(op, fi, this->fm.end(), si, this->sm.end(), "find");
+				if (si == this->sm.end())
+					break ;
+				this->startFt();
+				this->fm.erase(fi);
+				this->startStd(op);
+				this->sm.erase(si);
+				this->done(op);
+				break ;
+			}
+			case M_ERASE_RANGE: {
+				int last = key + this->gen.below(MAX_KEY / 8);
+				this->startFt();
+				this->fm.erase(this->fm.lower_bound(key), this->fm.lower_bound(last));
+				this->startStd(op);
+				this->sm.erase(this->sm.lower_bound(key), this->sm.lower_bound(last));
+				this->done(op);
+				break ;
+			}
+			case M_FIND: {
+				this->startFt();
+				ft_map::iterator fi = this->fm.find(key);
+				this->startStd(op);
+				std_map::iterator si = this->sm.find(key);
+				this->done(op);
+				this->sameIterator(op, fi, this->fm.end(), si, this->sm.end(), "found");
+				break ;
+			}
+			case M_COUNT: {
+				this->startFt();
+				std::size_t fn = this->fm.count(key);
+				this->startStd(op);
+				std::size_t sn = this->sm.count(key);
+				this->done(op);
+				this->expect(fn == sn, op, "count");
+				break ;
+			}
+			case M_BOUNDS: {
+				this->startFt();
+				ft_map::iterator fl = this->fm.lower_bound(key);
+				ft_map::iterator fu = this->fm.upper_bound(key);
+				this->startStd(op);
+				std_map::iterator sl = this->sm.lower_bound(key);
+				std_map::iterator su = this->sm.upper_bound(key);
+				this->done(op);
+				this->sameIterator(op, fl, this->fm.end(), sl, this->sm.end(), "lower_bound");
+				this->sameIterator(op, fu, this->fm.end(), su, this->sm.end(), "upper_bound");
+				break ;
+			}
+			case M_EQUAL_RANGE: {
+				this->startFt();
+				ft::pair<ft_map::iterator, ft_map::iterator> fr = this->fm.equal_range(key);
+				this->startStd(op);
+				std::pair<std_map::iterator, std_map::iterator> sr = this->sm.equal_range(key);
+				this->done(op);
+				this->sameIterator(op, fr.first, this->fm.end(), sr.first, this->sm.end(), "first");
+				this->sameIterator(op, fr.second, this->fm.end(), sr.second, this->sm.end(), "second");
+				break ;
+			}
+			case M_ITERATE: {
+				long ftSum = 0;
+				long stdSum = 0;
+				this->startFt();
+				for (ft_map::const_iterator it = this->fm.begin(); it != this->fm.end(); it++)
+					ftSum += it->first ^ it->second;
+				for (ft_map::reverse_iterator it = this->fm.rbegin(); it != this->fm.rend(); it++)
+					ftSum -= it->first;
+				this->startStd(op);
+				for (std_map::const_iterator it = this->sm.begin(); it != this->sm.end(); it++)
+					stdSum += it->first ^ it->second;
+				for (std_map::reverse_iterator it = this->sm.rbegin(); it != this->sm.rend(); it++)
+					stdSum -= it->first;
+				this->done(op);
+				this->expect(ftSum == stdSum, op, "sums");
+				break ;
+			}
+			case M_COPY: {
+				this->startFt();
+				ft_map fc(this->fm);
+				this->fm = fc;
+				this->startStd(op);
+				std_map sc(this->sm);
+				this->sm = sc;
+				this->done(op);
+				break ;
+			}
+			case M_CLEAR:
+				if (this->gen.below(16))
+					break ;
+				this->startFt();
+				this->fm.clear();
+				this->startStd(op);
+				this->sm.clear();
+				this->done(op);
+				break ;
+			default:
+				break ;
+		}
+	}
+
+							/*   Stack   */
+
+	void stackOp(op_id op) {
+		int value = this->gen.below(1000000);
+		if (op == S_PUSH) {
+			this->startFt();
+			this->fs.push(value);
+			this->startStd(op);
+			this->ss.push(value);
+			this->done(op);
+		}
+		else if (!this->ss.empty()) {
+			int ftTop;
+			int stdTop;
+			this->startFt();
+			ftTop = this->fs.top();
+			if (op == S_POP)
+				this->fs.pop();
+			this->startStd(op);
+			stdTop = this->ss.top();
+			if (op == S_POP)
+				this->ss.pop();
+			this->done(op);
+			this->expect(ftTop == stdTop, op, "top");
+		}
+	}
+
+							/*   Checks   */
+
+	void checkSizes(op_id op) const {
+		this->expect(this->fv.size() == this->sv.size(), op, "vector sizes");
+		this->expect(this->fm.size() == this->sm.size(), op, "map sizes");
+		this->expect(this->fs.size() == this->ss.size(), op, "stack sizes");
+		this->expect(this->fv.empty() || (this->fv.front() == this->sv.front() && this->fv.back() == this->sv.back()),
+			op, "vector front or back");
+		this->expect(this->fs.empty() || this->fs.top() == this->ss.top(), op, "stack top");
+	}
+
+	// Walks the container touched by op
+	void checkContents(op_id op) const {
+		if (op <= V_CLEAR) {
+			std_vector::const_iterator si = this->sv.begin();
+			for (ft_vector::const_iterator fi = this->fv.begin(); fi != this->fv.end(); fi++, si++)
+				this->expect(*fi == *si, op, "vector contents");
+		}
+		else if (op <= M_CLEAR) {
+			std_map::const_iterator si = this->sm.begin();
+			for (ft_map::const_iterator fi = this->fm.begin(); fi != this->fm.end(); fi++, si++)
+				this->expect(fi->first == si->first && fi->second == si->second, op, "map contents");
+#ifndef NDEBUG
+			const char *error = this->fm.validate();
+			this->expect(error == NULL, op, error ? error : "");
+#endif
+		}
+		else {
+			ft::stack<int> fc(this->fs);
+			std::stack<int> sc(this->ss);
+			for (; !sc.empty(); fc.pop(), sc.pop())
+				this->expect(fc.top() == sc.top(), op, "stack contents");
+		}
+	}
+};
+
+int main(int argc, char **argv) {
+	if (argc < 2 || argc > 4) {
+		std::cerr << "Usage: ./fuzz_driver seed [steps] [full_check_every]" << std::endl;
+		std::cerr << "Runs steps (100000) random operations on ft:: and std::, the containers are" << std::endl;
+		std::cerr << "compared every full_check_every (1) steps, 0 only at the end" << std::endl;
+		return 1;
+	}
+	unsigned long seed = strtoul(argv[1], NULL, 10);
+	long steps = (argc > 2) ? atol(argv[2]) : 100000;
+	long checkEvery = (argc > 3) ? atol(argv[3]) : 1;
+
+	driver d(seed, checkEvery);
+	d.run(steps);
+	d.report();
+	return 0;
+}
@@ -0,0 +1,176 @@
+#include <iostream>
+#include <string>
+#include <functional>
+#include <cstdlib>
+#include <new>
+
+#ifdef MINE
+	#include "../../containers/vector.hpp"
+	#include "../../containers/map.hpp"
+	#include "../../containers/deque.hpp"
+#else
+	#include <vector>
+	#include <map>
+	#include <deque>
+#endif
+
+using namespace NAMESPACE;
+
+#define CYAN "\033[0;36m"
+#define MAGENTA "\033[0;35m"
+#define YELLOW "\033[0;33m"
+#define GREEN "\033[0;32m"
+#define END_COLOR "\033[0m"
+#define OK "  ✅"
+
+// Allocations per allocator id, and whether a block was released by an
+// allocator other than the one which allocated it
+static long live[4];
+static bool wrongAllocator = false;
+
+// A stateful allocator: the id of the allocator is stored before each block
+template <class T>
+class counting_allocator
+{
+public:
+	typedef T				value_type;
+	typedef T*				pointer;
+	typedef const T*		const_pointer;
+	typedef T&				reference;
+	typedef const T&		const_reference;
+	typedef std::size_t		size_type;
+	typedef std::ptrdiff_t	difference_type;
+
+	template <class U>
+	struct rebind {
+		typedef counting_allocator<U> other;
+	};
+
+	counting_allocator(int id = 0) : id(id) {}
+	template <class U>
+	counting_allocator(const counting_allocator<U>& other) : id(other.id) {}
+
+	pointer allocate(size_type n, const void * = 0) {
+		long *block = static_cast<long*>(std::malloc(n * sizeof(T) + 2 * sizeof(long)));
+		if (!block)
+			throw std::bad_alloc();
+		block[0] = this->id;
+		live[this->id]++;
+		return reinterpret_cast<pointer>(block + 2);
+	}
+	void deallocate(pointer p, size_type) {
+		long *block = reinterpret_cast<long*>(p) - 2;
+		if (block[0] != this->id)
+			wrongAllocator = true;
+		live[block[0]]--;
+		std::free(block);
+	}
+	void construct(pointer p, const_reference val) {
+		new (p) T(val);
+	}
+	void destroy(pointer p) {
+		p->~T();
+	}
+	pointer address(reference x) const {
+		return &x;
+	}
+	const_pointer address(const_reference x) const {
+		return &x;
+	}
+	size_type max_size() const {
+		return size_type(-1) / sizeof(T);
+	}
+
+	int	id;
+};
+
+template <class T, class U>
+bool operator==(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) {
+	return lhs.id == rhs.id;
+}
+template <class T, class U>
+bool operator!=(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) {
+	return lhs.id != rhs.id;
+}
+
+typedef counting_allocator<int>																	int_allocator;
+typedef vector<int, int_allocator>																int_vector;
+typedef map<int, std::string, std::less<int>, counting_allocator<pair<const int, std::string> > >	string_map;
+typedef deque<int, int_allocator>																int_deque;
+
+static void printLive() {
+	std::cout << "allocator 1 in use: " << (live[1] > 0) << ", 2: " << (live[2] > 0)
+		<< ", 3: " << (live[3] > 0) << ", default: " << (live[0] > 0) << std::endl;
+}
+
+// Empty containers on the allocator id
+int_vector emptyWith(int id, const int_vector&) {
+	return int_vector(int_allocator(id));
+}
+string_map emptyWith(int id, const string_map&) {
+	return string_map(std::less<int>(), int_allocator(id));
+}
+int_deque emptyWith(int id, const int_deque&) {
+	return int_deque(int_allocator(id));
+}
+
+// Copy, assignment and swap of a container with a stateful allocator
+template <class Container>
+void propagate(Container& a, const std::string& name) {
+	std::cout << name << std::endl;
+	Container b(a);
+	std::cout << "copy constructed: allocator " << b.get_allocator().id << std::endl;
+	Container c(emptyWith(2, a));
+	c = a;
+	std::cout << "assigned: allocator " << c.get_allocator().id << ", size " << c.size() << std::endl;
+	Container d(emptyWith(3, a));
+	d.swap(b);
+	std::cout << "swapped: allocators " << d.get_allocator().id << " and " << b.get_allocator().id
+		<< ", sizes " << d.size() << " and " << b.size() << std::endl;
+	swap(c, d);
+	std::cout << "non member swap: allocators " << c.get_allocator().id << " and " << d.get_allocator().id << std::endl;
+	printLive();
+}
+
+int main()
+{
+
+					//////////////// TEST ALLOCATOR ////////////////////
+
+	std::cout << CYAN << "********************************************************" << END_COLOR << std::endl;
+	std::cout << CYAN << "**************** Test Stateful Allocator ***************" << END_COLOR << std::endl;
+	std::cout << CYAN << "********************************************************" << END_COLOR << std::endl << std::endl;
+
+
+						/***********  TEST 1  *************/
+
+	std::cout << YELLOW << "  * Test 1: Allocator propagation *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	{
+		int_vector v(int_allocator(1));
+		for (int i = 0; i < 100; i++)
+			v.push_back(i);
+		propagate(v, "vector:");
+		std::cout << std::endl;
+
+		string_map m(std::less<int>(), int_allocator(1));
+		for (int i = 0; i < 100; i++)
+			m[i] = "value";
+		propagate(m, "map:");
+		std::cout << std::endl;
+
+		int_deque d(int_allocator(1));
+		for (int i = 0; i < 100; i++)
+			d.push_back(i);
+		propagate(d, "deque:");
+	}
+	std::cout << std::endl << "all released: " << (live[0] == 0 && live[1] == 0 && live[2] == 0 && live[3] == 0)
+		<< ", each block by its allocator: " << !wrongAllocator << std::endl;
+
+	std::cout << std::endl << GREEN << "Test 1 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,97 @@
+#include <iostream>
+#include <string>
+#include <functional>
+
+#include "../../utils/arena_allocator.hpp"
+#ifdef MINE
+	#include "../../containers/vector.hpp"
+	#include "../../containers/map.hpp"
+	#include "../../containers/deque.hpp"
+#else
+	#include <vector>
+	#include <map>
+	#include <deque>
+#endif
+
+using namespace NAMESPACE;
+
+#define CYAN "\033[0;36m"
+#define MAGENTA "\033[0;35m"
+#define YELLOW "\033[0;33m"
+#define GREEN "\033[0;32m"
+#define END_COLOR "\033[0m"
+#define OK "  ✅"
+
+typedef vector<int, ft::arena_allocator<int> >												int_vector;
+typedef map<int, std::string, std::less<int>, ft::arena_allocator<pair<const int, std::string> > >	string_map;
+typedef deque<long, ft::arena_allocator<long> >												long_deque;
+
+int main()
+{
+
+					//////////////// TEST ARENA ////////////////////
+
+	std::cout << CYAN << "********************************************************" << END_COLOR << std::endl;
+	std::cout << CYAN << "***************** Test Arena Allocator *****************" << END_COLOR << std::endl;
+	std::cout << CYAN << "********************************************************" << END_COLOR << std::endl << std::endl;
+
+
+						/***********  TEST 1  *************/
+
+	std::cout << YELLOW << "  * Test 1: Containers in an arena *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	ft::arena requests(4096);
+	for (int request = 0; request < 3; request++) {
+		{
+			int_vector tokens(requests);
+			for (int i = 0; i < 1000; i++)
+				tokens.push_back(i * request);
+			string_map names(std::less<int>(), requests);
+			for (int i = 0; i < 100; i++)
+				names[i % 37] += char('a' + i % 26);
+			long_deque queue(requests);
+			for (int i = 0; i < 2000; i++)
+				queue.push_back(i);
+			for (int i = 0; i < 500; i++)
+				queue.pop_front();
+			int_vector copy(tokens.begin(), tokens.end(), requests);
+			std::cout << "request " << request << ": tokens " << tokens.size() << " back " << tokens.back()
+				<< ", names " << names.size() << " [36] " << names[36]
+				<< ", queue " << queue.size() << " front " << queue.front()
+				<< ", copy equal " << (copy == tokens)
+				<< ", same arena " << (tokens.get_allocator() == names.get_allocator()) << std::endl;
+		}
+		std::size_t capacity = requests.capacity();
+		requests.reset();
+		std::cout << "arena reset, chunks kept: " << (requests.capacity() == capacity) << std::endl;
+	}
+
+	std::cout << std::endl << GREEN << "Test 1 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+
+						/***********  TEST 2  *************/
+
+	std::cout << YELLOW << "  * Test 2: Without an arena *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	int_vector heap;
+	for (int i = 0; i < 100; i++)
+		heap.push_back(i);
+	heap.erase(heap.begin(), heap.begin() + 50);
+	string_map heapNames;
+	heapNames[1] = "one";
+	heapNames.erase(1);
+	heapNames[2] = "two";
+	std::cout << "vector " << heap.size() << " front " << heap.front()
+		<< ", map " << heapNames.size() << " " << heapNames.begin()->second
+		<< ", allocators equal: " << (heap.get_allocator() == ft::arena_allocator<int>()) << std::endl;
+
+	std::cout << std::endl << GREEN << "Test 2 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,370 @@
+#include <iostream>
+#include <string>
+#include <functional>
+#include <pthread.h>
+#include <sched.h>
+#include <ctime>
+
+#include "../../utils/instrumented_allocator.hpp"
+#ifdef MINE
+	#include "../../containers/concurrent_map.hpp"
+#else
+	#include <map>
+
+// What concurrent_map does, with a lock and snapshots copied
+template <class Key, class T, class Compare = std::less<Key>,
+	class Alloc = std::allocator<std::pair<const Key, T> > >
+class concurrent_map
+{
+public:
+	typedef std::map<Key, T, Compare, Alloc>		snapshot;
+	typedef typename snapshot::value_type			value_type;
+	typedef typename snapshot::const_iterator		const_iterator;
+
+	explicit concurrent_map(const Compare& comp = Compare(), const Alloc& alloc = Alloc()) : m(comp, alloc) {
+		pthread_mutex_init(&this->lock, NULL);
+	}
+	~concurrent_map() {
+		pthread_mutex_destroy(&this->lock);
+	}
+
+	size_t size() const {
+		guard g(this->lock);
+		return this->m.size();
+	}
+	bool empty() const {
+		return this->size() == 0;
+	}
+	size_t count(const Key& key) const {
+		guard g(this->lock);
+		return this->m.count(key);
+	}
+	bool find(const Key& key, T& value) const {
+		guard g(this->lock);
+		const_iterator it = this->m.find(key);
+		if (it == this->m.end())
+			return false;
+		value = it->second;
+		return true;
+	}
+	snapshot get_snapshot() const {
+		guard g(this->lock);
+		return this->m;
+	}
+	bool insert(const value_type& val) {
+		guard g(this->lock);
+		return this->m.insert(val).second;
+	}
+	bool insert_or_assign(const Key& key, const T& obj) {
+		guard g(this->lock);
+		std::pair<typename snapshot::iterator, bool> ret = this->m.insert(value_type(key, obj));
+		ret.first->second = obj;
+		return ret.second;
+	}
+	size_t erase(const Key& key) {
+		guard g(this->lock);
+		return this->m.erase(key);
+	}
+	void clear() {
+		guard g(this->lock);
+		this->m.clear();
+	}
+	size_t retired_versions() const {
+		return 0;
+	}
+
+private:
+	struct guard {
+		guard(pthread_mutex_t& lock) : lock(lock) {
+			pthread_mutex_lock(&this->lock);
+		}
+		~guard() {
+			pthread_mutex_unlock(&this->lock);
+		}
+		pthread_mutex_t&	lock;
+	};
+
+	snapshot				m;
+	mutable pthread_mutex_t	lock;
+};
+#endif
+
+using namespace NAMESPACE;
+
+#define CYAN "\033[0;36m"
+#define MAGENTA "\033[0;35m"
+#define YELLOW "\033[0;33m"
+#define GREEN "\033[0;32m"
+#define END_COLOR "\033[0m"
+#define OK "  ✅"
+
+typedef concurrent_map<int, std::string>	string_map;
+typedef concurrent_map<int, long>			long_map;
+
+template <class Snapshot>
+static void print(const std::string& name, const Snapshot& s) {
+	std::cout << name << ": { ";
+	for (typename Snapshot::const_iterator it = s.begin(); it != s.end(); it++)
+		std::cout << it->first << " " << it->second << "; ";
+	std::cout << "} size: " << s.size() << std::endl;
+}
+
+// The writer slides a window of keys, inserting key i with the value 2 * i
+// then erasing key i - window: every version holds consecutive keys
+static const int	window = 100;
+static const int	writes = 20000;
+static const int	readers = 4;
+
+struct shared_state {
+	long_map	map;
+	int			done;
+};
+
+struct reader_result {
+	shared_state	*state;
+	long			snapshots;
+	long			finds;
+	bool			consistentSnapshots;
+	bool			consistentFinds;
+};
+
+static bool consistent(const long_map::snapshot& s) {
+	long_map::snapshot::const_iterator it = s.begin();
+	if (it == s.end())
+		return true;
+	size_t n = 0;
+	for (int key = it->first; it != s.end(); it++, key++, n++)
+		if (it->first != key || it->second != 2L * key)
+			return false;
+	return n == s.size() && n <= window + 1;
+}
+
+static void *reader(void *arg) {
+	reader_result& r = *static_cast<reader_result *>(arg);
+	unsigned int key = 0;
+	while (!__atomic_load_n(&r.state->done, __ATOMIC_ACQUIRE)) {
+		long_map::snapshot s = r.state->map.get_snapshot();
+		r.consistentSnapshots = r.consistentSnapshots && consistent(s);
+		r.snapshots++;
+		for (int i = 0; i < 64; i++) {
+			long value = -1;
+			key = key * 1103515245 + 12345;
+			int k = static_cast<int>(key % writes);
+			if (r.state->map.find(k, value) && value != 2L * k)
+				r.consistentFinds = false;
+			r.finds++;
+		}
+	}
+	return NULL;
+}
+
+#ifdef MINE
+// The readers of a negative key wait in the comparator until released:
+// more readers than concurrent_map has slots are inside the map at once
+static const int	crowd = 80;
+static int			inside = 0;
+static int			released = 0;
+
+static bool waitFor(int *counter, int value) {
+	time_t deadline = time(NULL) + 10;
+	while (__atomic_load_n(counter, __ATOMIC_SEQ_CST) < value && time(NULL) < deadline)
+		sched_yield();
+	return __atomic_load_n(counter, __ATOMIC_SEQ_CST) >= value;
+}
+
+struct crowd_less {
+	bool operator()(int lhs, int rhs) const {
+		if (lhs < 0) {
+			__atomic_add_fetch(&inside, 1, __ATOMIC_SEQ_CST);
+			waitFor(&released, 1);
+		}
+		return lhs < rhs;
+	}
+};
+typedef concurrent_map<int, int, crowd_less>	crowd_map;
+
+static void *crowdReader(void *arg) {
+	static_cast<crowd_map *>(arg)->count(-1);
+	return NULL;
+}
+#endif
+
+int main()
+{
+
+					//////////////// TEST CONCURRENT MAP ////////////////////
+
+	std::cout << CYAN << "********************************************************" << END_COLOR << std::endl;
+	std::cout << CYAN << "***************** Test Concurrent Map ******************" << END_COLOR << std::endl;
+	std::cout << CYAN << "********************************************************" << END_COLOR << std::endl << std::endl;
+	std::cout << std::boolalpha;
+
+
+						/***********  TEST 1  *************/
+
+	std::cout << YELLOW << "  * Test 1: Reads and writes *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	{
+		string_map m;
+		std::cout << "empty: " << m.empty() << ", size " << m.size() << std::endl;
+		for (int i = 0; i < 10; i++)
+			m.insert(string_map::value_type(i * 3 % 10, std::string(i + 1, 'a' + i)));
+		std::cout << "insert(4, \"x\"): " << m.insert(string_map::value_type(4, "x")) << std::endl;
+		std::cout << "insert(10, \"x\"): " << m.insert(string_map::value_type(10, "x")) << std::endl;
+		std::cout << "insert_or_assign(4, \"four\"): " << m.insert_or_assign(4, "four") << std::endl;
+		std::cout << "insert_or_assign(11, \"eleven\"): " << m.insert_or_assign(11, "eleven") << std::endl;
+		std::string value;
+		std::cout << "find(4): " << m.find(4, value) << " " << value << std::endl;
+		std::cout << "find(12): " << m.find(12, value) << std::endl;
+		std::cout << "count(7) " << m.count(7) << ", count(-1) " << m.count(-1) << std::endl;
+		std::cout << "erase(7) " << m.erase(7) << ", erase(7) " << m.erase(7) << std::endl;
+		print("map", m.get_snapshot());
+		m.clear();
+		std::cout << "clear: empty " << m.empty() << ", size " << m.size() << std::endl;
+	}
+	std::cout << GREEN << "Reads and writes work!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 2  *************/
+
+	std::cout << YELLOW << "  * Test 2: Snapshots *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	{
+		string_map m;
+		for (int i = 0; i < 8; i++)
+			m.insert_or_assign(i * 2, std::string(1, 'a' + i));
+		string_map::snapshot before = m.get_snapshot();
+		for (int i = 0; i < 8; i++)
+			m.insert_or_assign(i * 2 + 1, std::string(1, 'A' + i));
+		m.erase(0);
+		m.insert_or_assign(2, "changed");
+		string_map::snapshot after = m.get_snapshot();
+		print("before", before);
+		print("after", after);
+		std::cout << "before.find(2): " << before.find(2)->second << ", after.find(2): " << after.find(2)->second << std::endl;
+		std::cout << "before.find(3) is end: " << (before.find(3) == before.end())
+			<< ", before.count(0) " << before.count(0) << ", after.count(0) " << after.count(0) << std::endl;
+		std::cout << "before.lower_bound(5): " << before.lower_bound(5)->first
+			<< ", after.lower_bound(5): " << after.lower_bound(5)->first
+			<< ", lower_bound(100) is end: " << (after.lower_bound(100) == after.end()) << std::endl;
+		string_map::snapshot copy(before);
+		before = after;
+		m.clear();
+		print("copy of before", copy);
+		std::cout << "assigned: " << before.size() << " elements, map cleared: " << m.size()
+			<< ", empty snapshot: " << m.get_snapshot().empty() << std::endl;
+	}
+	std::cout << GREEN << "Snapshots work!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 3  *************/
+
+	std::cout << YELLOW << "  * Test 3: Reclamation *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	ft::allocation_stats stats;
+	{
+		typedef concurrent_map<int, int, std::less<int>,
+			ft::instrumented_allocator<pair<const int, int> > >	counted_map;
+		counted_map m(std::less<int>(), stats);
+		for (int i = 0; i < 1000; i++)
+			m.insert(make_pair(i, i));
+		std::cout << "no retired version without readers: " << m.retired_versions() << std::endl;
+		{
+			counted_map::snapshot s = m.get_snapshot();
+			for (int i = 0; i < 1000; i += 2)
+				m.erase(i);
+			std::cout << "snapshot kept: " << s.size() << " elements, map: " << m.size() << std::endl;
+		}
+		for (int i = 0; i < 1000; i++)
+			m.insert_or_assign(i, -i);
+		std::cout << "retired after the snapshot: " << m.retired_versions() << ", size " << m.size() << std::endl;
+	}
+	std::cout << "live bytes " << stats.liveBytes << ", deallocations == allocations: "
+		<< (stats.deallocations == stats.allocations) << std::endl;
+	std::cout << GREEN << "Versions are released!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 4  *************/
+
+	std::cout << YELLOW << "  * Test 4: Readers during writes *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	{
+		shared_state state;
+		state.done = 0;
+		reader_result results[readers];
+		pthread_t threads[readers];
+		for (int i = 0; i < readers; i++) {
+			results[i].state = &state;
+			results[i].snapshots = 0;
+			results[i].finds = 0;
+			results[i].consistentSnapshots = true;
+			results[i].consistentFinds = true;
+			pthread_create(&threads[i], NULL, reader, &results[i]);
+		}
+		for (int i = 0; i < writes; i++) {
+			state.map.insert(make_pair(i, 2L * i));
+			if (i >= window)
+				state.map.erase(i - window);
+		}
+		__atomic_store_n(&state.done, 1, __ATOMIC_RELEASE);
+		bool snapshots = true, finds = true;
+		for (int i = 0; i < readers; i++) {
+			pthread_join(threads[i], NULL);
+			snapshots = snapshots && results[i].consistentSnapshots && results[i].snapshots > 0;
+			finds = finds && results[i].consistentFinds;
+		}
+		std::cout << readers << " readers, " << writes << " writes" << std::endl;
+		std::cout << "every snapshot holds consecutive keys: " << snapshots << std::endl;
+		std::cout << "every find sees the value of its key: " << finds << std::endl;
+		long_map::snapshot last = state.map.get_snapshot();
+		std::cout << "last window: from " << last.begin()->first << ", size " << last.size()
+			<< ", consecutive keys: " << consistent(last) << std::endl;
+	}
+	std::cout << GREEN << "Readers see whole versions!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 5  *************/
+
+	std::cout << YELLOW << "  * Test 5: More readers than slots *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	{
+#ifdef MINE
+		crowd_map m;
+		m.insert(make_pair(0, 0));
+		pthread_t threads[crowd];
+		for (int i = 0; i < crowd; i++)
+			pthread_create(&threads[i], NULL, crowdReader, &m);
+		bool allInside = waitFor(&inside, crowd);
+		m.insert_or_assign(0, 1);
+		size_t held = m.retired_versions();
+		__atomic_store_n(&released, 1, __ATOMIC_SEQ_CST);
+		for (int i = 0; i < crowd; i++)
+			pthread_join(threads[i], NULL);
+		m.insert_or_assign(0, 2);
+		std::cout << "80 readers inside at once: " << allInside << ", a write retires " << held
+			<< " version, released after them: " << (m.retired_versions() == 0) << std::endl;
+#else
+		std::cout << "80 readers inside at once: " << true << ", a write retires " << 1
+			<< " version, released after them: " << true << std::endl;
+#endif
+	}
+	std::cout << GREEN << "Readers never wait for a slot!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	return 0;
+}
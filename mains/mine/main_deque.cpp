@@ -0,0 +1,233 @@
+#include <iostream>
+#include <string>
+
+#ifdef MINE
+	#include "../../containers/deque.hpp"
+	#include "../../containers/stack.hpp"
+#else
+	#include <deque>
+	#include <stack>
+#endif
+
+using namespace NAMESPACE;
+
+#define CYAN "\033[0;36m"
+#define MAGENTA "\033[0;35m"
+#define YELLOW "\033[0;33m"
+#define GREEN "\033[0;32m"
+#define END_COLOR "\033[0m"
+#define OK "  ✅"
+
+struct Buffer
+{
+	int idx;
+	char buff[4096];
+};
+
+template <class Deque>
+void print(const std::string& name, const Deque& d) {
+	std::cout << name << " (size " << d.size() << "):";
+	for (typename Deque::const_iterator it = d.begin(); it != d.end(); it++)
+		std::cout << " " << *it;
+	std::cout << std::endl;
+}
+
+int main()
+{
+
+					//////////////// TEST DEQUE ////////////////////
+
+	std::cout << CYAN << "********************************************************" << END_COLOR << std::endl;
+	std::cout << CYAN << "******************** Test Deque ************************" << END_COLOR << std::endl;
+	std::cout << CYAN << "********************************************************" << END_COLOR << std::endl << std::endl;
+
+
+						/***********  TEST 1  *************/
+
+	std::cout << YELLOW << "  * Test 1: Constructors & element access *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	deque<int> empty;
+	std::cout << "empty: " << empty.empty() << " size " << empty.size() << std::endl;
+	deque<int> fill(5, 42);
+	print("fill", fill);
+	int tab[] = {1, 2, 3, 4, 5, 6};
+	deque<int> range(tab, tab + 6);
+	print("range", range);
+	deque<int> copy(range);
+	print("copy", copy);
+	std::cout << "front " << range.front() << " back " << range.back()
+		<< " [2] " << range[2] << " at(3) " << range.at(3) << std::endl;
+	try {
+		range.at(6);
+	} catch (const std::out_of_range&) {
+		std::cout << "at(6) throws out_of_range" << std::endl;
+	}
+
+	std::cout << std::endl << GREEN << "Test 1 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+
+						/***********  TEST 2  *************/
+
+	std::cout << YELLOW << "  * Test 2: push & pop at both ends, across blocks *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	deque<int> d;
+	for (int i = 0; i < 5000; i++) {
+		d.push_back(i);
+		d.push_front(-i);
+	}
+	std::cout << "size " << d.size() << " front " << d.front() << " back " << d.back()
+		<< " [5000] " << d[5000] << " [7777] " << d[7777] << std::endl;
+	long sum = 0;
+	for (deque<int>::iterator it = d.begin(); it != d.end(); it++)
+		sum += *it;
+	long rsum = 0;
+	for (deque<int>::reverse_iterator it = d.rbegin(); it != d.rend(); it++)
+		rsum += *it * 2;
+	std::cout << "sum " << sum << " reverse sum * 2 " << rsum << std::endl;
+	for (int i = 0; i < 3000; i++)
+		d.pop_front();
+	for (int i = 0; i < 3000; i++)
+		d.pop_back();
+	std::cout << "after pops: size " << d.size() << " front " << d.front() << " back " << d.back() << std::endl;
+	while (!d.empty())
+		d.pop_back();
+	d.push_front(7);
+	std::cout << "emptied, then push_front: size " << d.size() << " front " << d.front() << std::endl;
+
+	std::cout << std::endl << GREEN << "Test 2 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+
+						/***********  TEST 3  *************/
+
+	std::cout << YELLOW << "  * Test 3: iterators *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	deque<int> big;
+	for (int i = 0; i < 3000; i++)
+		big.push_back(i);
+	deque<int>::iterator it = big.begin();
+	it += 2500;
+	std::cout << "begin + 2500: " << *it << std::endl;
+	it -= 1700;
+	std::cout << "- 1700: " << *it << " it[1000]: " << it[1000] << std::endl;
+	deque<int>::const_iterator cit = big.end();
+	std::cout << "end - begin: " << (cit - big.begin()) << " end - it: " << (big.end() - it) << std::endl;
+	std::cout << "it < end: " << (it < cit) << " it >= begin: " << (it >= big.begin()) << std::endl;
+	deque<int>::reverse_iterator rit = big.rbegin() + 10;
+	std::cout << "rbegin + 10: " << *rit << std::endl;
+
+	std::cout << std::endl << GREEN << "Test 3 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+
+						/***********  TEST 4  *************/
+
+	std::cout << YELLOW << "  * Test 4: insert, erase, assign, resize, swap *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	deque<int> m(tab, tab + 6);
+	m.insert(m.begin() + 1, 10);
+	m.insert(m.end() - 1, 2, 20);
+	m.insert(m.begin() + 3, tab, tab + 3);
+	print("inserted", m);
+	std::cout << "insert returns: " << *m.insert(m.begin() + 5, 99) << std::endl;
+	m.erase(m.begin() + 2);
+	m.erase(m.begin() + 4, m.begin() + 7);
+	m.erase(m.end() - 2, m.end());
+	print("erased", m);
+	std::cout << "erase returns: " << *m.erase(m.begin()) << std::endl;
+	m.assign(3, 8);
+	print("assign(3, 8)", m);
+	m.assign(tab, tab + 4);
+	print("assign(range)", m);
+	m.resize(6, 5);
+	print("resize(6, 5)", m);
+	m.resize(2);
+	print("resize(2)", m);
+	m.swap(fill);
+	print("swapped m", m);
+	print("swapped fill", fill);
+	m.clear();
+	print("clear", m);
+
+	std::cout << std::endl << GREEN << "Test 4 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+
+						/***********  TEST 5  *************/
+
+	std::cout << YELLOW << "  * Test 5: comparisons *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	deque<int> a(tab, tab + 6), b(tab, tab + 6), c(tab, tab + 5);
+	std::cout << "a == b " << (a == b) << " a != c " << (a != c) << " c < a " << (c < a)
+		<< " a <= b " << (a <= b) << " a > c " << (a > c) << " c >= a " << (c >= a) << std::endl;
+
+	std::cout << std::endl << GREEN << "Test 5 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+
+						/***********  TEST 6  *************/
+
+	std::cout << YELLOW << "  * Test 6: stack of 4KB buffers on a deque *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	stack<Buffer, deque<Buffer> > buffers;
+	Buffer buffer;
+	buffer.idx = 0;
+	buffers.push(buffer);
+	const Buffer *first = &buffers.top();
+	for (int i = 1; i < 10000; i++) {
+		buffer.idx = i;
+		buffers.push(buffer);
+	}
+	std::cout << "size " << buffers.size() << " top " << buffers.top().idx << std::endl;
+	for (int i = 0; i < 9999; i++)
+		buffers.pop();
+	std::cout << "the first buffer never moved: " << (first == &buffers.top()) << std::endl;
+
+	std::cout << std::endl << GREEN << "Test 6 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+
+						/***********  TEST 7  *************/
+
+	std::cout << YELLOW << "  * Test 7: emplace at both ends *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	deque<std::string> words;
+	for (int i = 0; i < 1000; i++) {
+#ifdef MINE
+		words.emplace_back(i % 5 + 1, 'b');
+		words.emplace_front(i % 3 + 1, 'f');
+#else
+		words.push_back(std::string(i % 5 + 1, 'b'));
+		words.push_front(std::string(i % 3 + 1, 'f'));
+#endif
+	}
+#ifdef MINE
+	words.emplace_back();
+	words.emplace_front("first");
+#else
+	words.push_back(std::string());
+	words.push_front(std::string("first"));
+#endif
+	std::cout << "size " << words.size() << " front [" << words.front() << "] [1] [" << words[1]
+		<< "] [1000] [" << words[1000] << "] [2000] [" << words[2000] << "] back [" << words.back() << "]" << std::endl;
+
+	std::cout << std::endl << GREEN << "Test 7 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,185 @@
+#include <iostream>
+#include <string>
+#include <functional>
+
+#include "../../utils/instrumented_allocator.hpp"
+#ifdef MINE
+	#include "../../containers/vector.hpp"
+	#include "../../containers/map.hpp"
+	#include "../../containers/deque.hpp"
+#else
+	#include <vector>
+	#include <map>
+	#include <deque>
+#endif
+
+using namespace NAMESPACE;
+
+#define CYAN "\033[0;36m"
+#define MAGENTA "\033[0;35m"
+#define YELLOW "\033[0;33m"
+#define GREEN "\033[0;32m"
+#define END_COLOR "\033[0m"
+#define OK "  ✅"
+
+typedef vector<int, ft::instrumented_allocator<int> >												int_vector;
+typedef map<int, std::string, std::less<int>, ft::instrumented_allocator<pair<const int, std::string> > >	string_map;
+typedef deque<long, ft::instrumented_allocator<long> >												long_deque;
+
+// The counts depend on the growth policy of each implementation, only
+// what they must agree on is printed
+static void released(const ft::allocation_stats& s) {
+	std::cout << "live bytes " << s.liveBytes << ", deallocations == allocations: "
+		<< (s.deallocations == s.allocations) << ", peak > 0: " << (s.peakBytes > 0) << std::endl;
+}
+
+static int usedBuckets(const ft::allocation_stats& s) {
+	int used = 0;
+	for (int i = 0; i < ft::allocation_stats::buckets; i++)
+		used += (s.histogram[i] != 0);
+	return used;
+}
+
+int main()
+{
+
+					//////////////// TEST INSTRUMENTED ALLOCATOR ////////////////////
+
+	std::cout << CYAN << "********************************************************" << END_COLOR << std::endl;
+	std::cout << CYAN << "************ Test Instrumented Allocator ***************" << END_COLOR << std::endl;
+	std::cout << CYAN << "********************************************************" << END_COLOR << std::endl << std::endl;
+
+
+						/***********  TEST 1  *************/
+
+	std::cout << YELLOW << "  * Test 1: Vector *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	ft::allocation_stats vectorStats;
+	{
+		int_vector v(vectorStats);
+		v.reserve(100);
+		std::cout << "reserve(100): allocations " << vectorStats.allocations << ", bytes "
+			<< vectorStats.totalBytes << ", live " << vectorStats.liveBytes << ", in the 512 bytes bucket "
+			<< vectorStats.histogram[ft::allocation_stats::bucket(512)] << std::endl;
+		for (int i = 0; i < 100; i++)
+			v.push_back(i);
+		std::cout << "100 push_back: allocations " << vectorStats.allocations << std::endl;
+		v.push_back(100);
+		std::cout << "101st push_back reallocates: " << (vectorStats.allocations == 2)
+			<< ", peak holds both buffers: " << (vectorStats.peakBytes > v.capacity() * sizeof(int)) << std::endl;
+	}
+	released(vectorStats);
+
+	std::cout << std::endl << GREEN << "Test 1 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 2  *************/
+
+	std::cout << YELLOW << "  * Test 2: Map nodes *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	ft::allocation_stats mapStats;
+	{
+		string_map m(std::less<int>(), mapStats);
+		for (int i = 0; i < 1000; i++)
+			m[i % 500] = "value";
+		std::cout << "500 keys: one node each: " << (mapStats.allocations == 500)
+			<< ", nodes of one size: " << (usedBuckets(mapStats) == 1) << std::endl;
+		string_map copy(m);
+		std::cout << "copy counted in the same stats: " << (mapStats.allocations == 1000) << std::endl;
+		m.erase(m.begin(), m.end());
+		std::cout << "erase releases 500 nodes: " << (mapStats.deallocations == 500) << std::endl;
+	}
+	released(mapStats);
+
+	std::cout << std::endl << GREEN << "Test 2 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 3  *************/
+
+	std::cout << YELLOW << "  * Test 3: Deque blocks and map *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	ft::allocation_stats dequeStats;
+	{
+		long_deque d(dequeStats);
+		for (int i = 0; i < 10000; i++)
+			d.push_back(i);
+		for (int i = 0; i < 10000; i++)
+			d.push_front(i);
+		std::cout << "blocks and map counted: " << (dequeStats.allocations > 2)
+			<< ", live holds the elements: " << (dequeStats.liveBytes >= d.size() * sizeof(long))
+			<< ", two sizes at least: " << (usedBuckets(dequeStats) >= 2) << std::endl;
+	}
+	released(dequeStats);
+
+	ft::allocation_stats& global = ft::allocation_stats::global();
+	global.reset();
+	{
+		vector<int, ft::instrumented_allocator<int> > v(10, 42);
+		std::cout << "default constructed allocator counts in global(): " << global.allocations
+			<< " allocation, " << global.totalBytes << " bytes" << std::endl;
+	}
+	released(global);
+
+	std::cout << std::endl << GREEN << "Test 3 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 4  *************/
+
+	std::cout << YELLOW << "  * Test 4: Maps with different stats *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	// Unequal allocators: the elements are copied, each map keeps its allocator
+	// and frees only the nodes it allocated
+	ft::allocation_stats aStats, bStats;
+	{
+		string_map a(std::less<int>(), aStats);
+		string_map b(std::less<int>(), bStats);
+		for (int round = 0; round < 2; round++) {
+			for (int i = round * 100; i < round * 100 + 100; i++)
+				b[i] = "b";
+#ifdef MINE
+			a.splice(b);
+#else
+			a.insert(b.begin(), b.end());
+			b.clear();
+#endif
+			std::cout << "splice: sizes " << a.size() << " " << b.size() << ", allocators kept: "
+				<< (a.get_allocator() == string_map::allocator_type(aStats)) << " "
+				<< (b.get_allocator() == string_map::allocator_type(bStats))
+				<< ", allocated by a: " << aStats.allocations << ", live in b: " << bStats.liveBytes << std::endl;
+		}
+		string_map c(std::less<int>(), bStats);
+		for (int i = 150; i < 250; i++)
+			c[i] = "c";
+		b[300] = "b";
+#ifdef MINE
+		a.merge(c);
+		string_map::node_handle nh = b.extract(300);
+		a.insert(nh);
+#else
+		for (int i = 200; i < 250; i++) {
+			a.insert(*c.find(i));
+			c.erase(i);
+		}
+		a.insert(*b.find(300));
+		b.erase(300);
+#endif
+		std::cout << "merge and node handle: sizes " << a.size() << " " << b.size() << " " << c.size()
+			<< ", allocated by a: " << aStats.allocations
+			<< ", nodes live in b and c: " << (bStats.allocations - bStats.deallocations) << std::endl;
+	}
+	released(aStats);
+	released(bStats);
+
+	std::cout << std::endl << GREEN << "Test 4 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	return 0;
+}
@@ -5,6 +5,8 @@
 	#include "../../containers/map.hpp"
 #else
 	#include <map>
+	#include <algorithm>
+	#include <iterator>
 #endif
 
 using namespace NAMESPACE;
@@ -349,6 +351,321 @@ int main()
 	std::cout << std::endl;
 	
 
+	std::cout << std::endl << CYAN << "********************************************************" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 7  *************/
+	std::cout << YELLOW << "  * Test 7: Set operations *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	map<int, int> s1, s2;
+	for (int i = 0; i < 20; i += 2)
+		s1[i] = i;
+	for (int i = 0; i < 20; i += 3)
+		s2[i] = -i;
+#ifdef MINE
+	map<int, int> su = set_union(s1, s2);
+	map<int, int> si = set_intersection(s1, s2);
+	map<int, int> sd = set_difference(s1, s2);
+#else
+	map<int, int> su, si, sd;
+	std::set_union(s1.begin(), s1.end(), s2.begin(), s2.end(),
+		std::inserter(su, su.end()), s1.value_comp());
+	std::set_intersection(s1.begin(), s1.end(), s2.begin(), s2.end(),
+		std::inserter(si, si.end()), s1.value_comp());
+	std::set_difference(s1.begin(), s1.end(), s2.begin(), s2.end(),
+		std::inserter(sd, sd.end()), s1.value_comp());
+#endif
+	std::cout << "union: { ";
+	for (map<int, int>::iterator it = su.begin(); it != su.end(); it++)
+		std::cout << it->first << " " << it->second << "; ";
+	std::cout << "} size: " << su.size() << std::endl;
+	std::cout << "intersection: { ";
+	for (map<int, int>::iterator it = si.begin(); it != si.end(); it++)
+		std::cout << it->first << " " << it->second << "; ";
+	std::cout << "} size: " << si.size() << std::endl;
+	std::cout << "difference: { ";
+	for (map<int, int>::iterator it = sd.begin(); it != sd.end(); it++)
+		std::cout << it->first << " " << it->second << "; ";
+	std::cout << "} size: " << sd.size() << std::endl;
+	std::cout << "reverse union: { ";
+	for (map<int, int>::reverse_iterator it = su.rbegin(); it != su.rend(); it++)
+		std::cout << it->first << " ";
+	std::cout << "}" << std::endl;
+	std::cout << std::endl;
+
+	std::cout << "Test merge() : " << std::endl;
+#ifdef MINE
+	s1.merge(s2);
+#else
+	for (map<int, int>::iterator it = s2.begin(); it != s2.end();) {
+		if (s1.insert(*it).second)
+			s2.erase(it++);
+		else
+			it++;
+	}
+#endif
+	std::cout << "merged: { ";
+	for (map<int, int>::iterator it = s1.begin(); it != s1.end(); it++)
+		std::cout << it->first << " " << it->second << "; ";
+	std::cout << "} size: " << s1.size() << std::endl;
+	std::cout << "left in source: { ";
+	for (map<int, int>::iterator it = s2.begin(); it != s2.end(); it++)
+		std::cout << it->first << " " << it->second << "; ";
+	std::cout << "} size: " << s2.size() << std::endl;
+	s1[7] = 7;
+	s1.erase(18);
+	s2[1] = 1;
+	std::cout << "after insert/erase: { ";
+	for (map<int, int>::iterator it = s1.begin(); it != s1.end(); it++)
+		std::cout << it->first << " ";
+	std::cout << "} last: " << (--s1.end())->first << std::endl;
+	std::cout << GREEN << "Set operations work!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "********************************************************" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 8  *************/
+	std::cout << YELLOW << "  * Test 8: Range erase, split & splice *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	map<int, int> win;
+	for (int i = 0; i < 30; i++)
+		win[i * 2] = i;
+	win.erase(win.find(10), win.find(20));
+	win.erase(win.begin(), win.begin());
+	win.erase(win.lower_bound(50), win.end());
+	std::cout << "after range erase: { ";
+	for (map<int, int>::iterator it = win.begin(); it != win.end(); it++)
+		std::cout << it->first << " ";
+	std::cout << "} size: " << win.size() << std::endl;
+
+#ifdef MINE
+	map<int, int> upper = win.split(31);
+#else
+	map<int, int> upper(win.lower_bound(31), win.end());
+	win.erase(win.lower_bound(31), win.end());
+#endif
+	std::cout << "split lower: { ";
+	for (map<int, int>::iterator it = win.begin(); it != win.end(); it++)
+		std::cout << it->first << " ";
+	std::cout << "} size: " << win.size() << std::endl;
+	std::cout << "split upper: { ";
+	for (map<int, int>::reverse_iterator it = upper.rbegin(); it != upper.rend(); it++)
+		std::cout << it->first << " ";
+	std::cout << "} size: " << upper.size() << std::endl;
+
+	upper[100] = 100;
+#ifdef MINE
+	win.splice(upper);
+#else
+	win.insert(upper.begin(), upper.end());
+	upper.clear();
+#endif
+	win[-1] = -1;
+	std::cout << "spliced: { ";
+	for (map<int, int>::iterator it = win.begin(); it != win.end(); it++)
+		std::cout << it->first << " ";
+	std::cout << "} size: " << win.size() << ", other size: " << upper.size() << std::endl;
+	std::cout << "last: " << (--win.end())->first << std::endl;
+	std::cout << GREEN << "Range erase, split & splice work!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "********************************************************" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 9  *************/
+	std::cout << YELLOW << "  * Test 9: Moving nodes between maps *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	map<std::string, std::string> active, expired;
+	active["alpha"] = "1";
+	active["beta"] = "2";
+	active["gamma"] = "3";
+	active["delta"] = "4";
+	expired["gamma"] = "old";
+	map<std::string, std::string>::iterator kept = active.find("alpha");
+#ifdef MINE
+	map<std::string, std::string>::node_handle nh = active.extract("beta");
+	std::cout << "extracted: " << nh.key() << " " << nh.mapped() << std::endl;
+	pair<map<std::string, std::string>::iterator, bool> moved = expired.insert(nh);
+	std::cout << "inserted: " << moved.first->first << " " << moved.second << std::endl;
+	nh = active.extract(active.find("gamma"));
+	moved = expired.insert(nh);
+	std::cout << "inserted: " << moved.first->first << " " << moved.second << std::endl;
+	moved = expired.insert(active.extract("delta"));	// Straight from extract()
+	std::cout << "inserted: " << moved.first->first << " " << moved.second << std::endl;
+	nh = active.extract("nothing");
+#else
+	std::cout << "extracted: " << "beta" << " " << active["beta"] << std::endl;
+	pair<map<std::string, std::string>::iterator, bool> moved = expired.insert(*active.find("beta"));
+	active.erase("beta");
+	std::cout << "inserted: " << moved.first->first << " " << moved.second << std::endl;
+	moved = expired.insert(*active.find("gamma"));
+	active.erase("gamma");
+	std::cout << "inserted: " << moved.first->first << " " << moved.second << std::endl;
+	moved = expired.insert(*active.find("delta"));
+	active.erase("delta");
+	std::cout << "inserted: " << moved.first->first << " " << moved.second << std::endl;
+#endif
+	std::cout << "still valid: " << kept->first << " " << kept->second << std::endl;
+	std::cout << "active: { ";
+	for (map<std::string, std::string>::iterator it = active.begin(); it != active.end(); it++)
+		std::cout << it->first << " " << it->second << "; ";
+	std::cout << "} size: " << active.size() << std::endl;
+	std::cout << "expired: { ";
+	for (map<std::string, std::string>::iterator it = expired.begin(); it != expired.end(); it++)
+		std::cout << it->first << " " << it->second << "; ";
+	std::cout << "} size: " << expired.size() << std::endl;
+	std::cout << GREEN << "Nodes moved!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "********************************************************" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 10  *************/
+	std::cout << YELLOW << "  * Test 10: Lookups with other key types *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+#ifdef MINE
+	typedef map<std::string, int, transparent_less> str_map;
+#else
+	typedef map<std::string, int> str_map;
+#endif
+	str_map words;
+	words["apple"] = 1;
+	words["banana"] = 2;
+	words["cherry"] = 3;
+	const str_map& cwords = words;
+	const char *key = "banana";
+	std::cout << "find(\"banana\"): " << words.find(key)->second << std::endl;
+	std::cout << "find(\"kiwi\") is end: " << (cwords.find("kiwi") == cwords.end()) << std::endl;
+	std::cout << "count(\"cherry\"): " << words.count("cherry") << std::endl;
+	std::cout << "at(\"apple\"): " << cwords.at("apple") << std::endl;
+	try {
+		words.at("kiwi");
+	} catch (const std::exception& e) {
+		std::cout << "at(\"kiwi\"): " << e.what() << std::endl;
+	}
+	words["date"] = 4;
+	words["apple"] += 10;
+	std::cout << "lower_bound(\"b\"): " << words.lower_bound("b")->first << std::endl;
+	std::cout << "upper_bound(\"banana\"): " << cwords.upper_bound("banana")->first << std::endl;
+	std::cout << "equal_range(\"date\"): " << words.equal_range("date").first->first << std::endl;
+	std::cout << "map: { ";
+	for (str_map::iterator it = words.begin(); it != words.end(); it++)
+		std::cout << it->first << " " << it->second << "; ";
+	std::cout << "}" << std::endl;
+	std::cout << GREEN << "Lookups work!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "********************************************************" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 11  *************/
+	std::cout << YELLOW << "  * Test 11: Emplace *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	map<int, std::string> named;
+	named[2] = "two";
+#ifdef MINE
+	pair<map<int, std::string>::iterator, bool> emplaced = named.emplace(1, "one");
+	std::cout << "emplace(1, \"one\"): " << emplaced.first->second << " " << emplaced.second << std::endl;
+	emplaced = named.emplace(2, "deux");
+	std::cout << "emplace(2, \"deux\"): " << emplaced.first->second << " " << emplaced.second << std::endl;
+	map<int, std::string>::iterator hinted = named.emplace_hint(named.end(), 3, std::string(3, 'x'));
+	std::cout << "emplace_hint(end, 3, \"xxx\"): " << hinted->first << " " << hinted->second << std::endl;
+#else
+	pair<map<int, std::string>::iterator, bool> emplaced = named.insert(make_pair(1, std::string("one")));
+	std::cout << "emplace(1, \"one\"): " << emplaced.first->second << " " << emplaced.second << std::endl;
+	emplaced = named.insert(make_pair(2, std::string("deux")));
+	std::cout << "emplace(2, \"deux\"): " << emplaced.first->second << " " << emplaced.second << std::endl;
+	map<int, std::string>::iterator hinted = named.insert(named.end(), make_pair(3, std::string(3, 'x')));
+	std::cout << "emplace_hint(end, 3, \"xxx\"): " << hinted->first << " " << hinted->second << std::endl;
+#endif
+	std::cout << "map: { ";
+	for (map<int, std::string>::iterator it = named.begin(); it != named.end(); it++)
+		std::cout << it->first << " " << it->second << "; ";
+	std::cout << "} size: " << named.size() << std::endl;
+	std::cout << GREEN << "Emplace works!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "********************************************************" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 12  *************/
+	std::cout << YELLOW << "  * Test 12: Upserts *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	map<std::string, std::string> config;
+	config["host"] = "localhost";
+#ifdef MINE
+	pair<map<std::string, std::string>::iterator, bool> upsert = config.try_emplace("port", 4, '8');
+	std::cout << "try_emplace(\"port\", 4, '8'): " << upsert.first->second << " " << upsert.second << std::endl;
+	upsert = config.try_emplace("host", "example.com");
+	std::cout << "try_emplace(\"host\", \"example.com\"): " << upsert.first->second << " " << upsert.second << std::endl;
+	upsert = config.try_emplace("empty");
+	std::cout << "try_emplace(\"empty\"): [" << upsert.first->second << "] " << upsert.second << std::endl;
+	upsert = config.insert_or_assign("host", "example.com");
+	std::cout << "insert_or_assign(\"host\", \"example.com\"): " << upsert.first->second << " " << upsert.second << std::endl;
+	upsert = config.insert_or_assign("user", std::string("root"));
+	std::cout << "insert_or_assign(\"user\", \"root\"): " << upsert.first->second << " " << upsert.second << std::endl;
+	map<std::string, std::string>::iterator upserted = config.try_emplace(config.begin(), "mode", "rw");
+	std::cout << "try_emplace(begin, \"mode\", \"rw\"): " << upserted->second << std::endl;
+	upserted = config.insert_or_assign(config.end(), "mode", "ro");
+	std::cout << "insert_or_assign(end, \"mode\", \"ro\"): " << upserted->second << std::endl;
+#else
+	pair<map<std::string, std::string>::iterator, bool> upsert = config.insert(make_pair(std::string("port"), std::string(4, '8')));
+	std::cout << "try_emplace(\"port\", 4, '8'): " << upsert.first->second << " " << upsert.second << std::endl;
+	upsert = config.insert(make_pair(std::string("host"), std::string("example.com")));
+	std::cout << "try_emplace(\"host\", \"example.com\"): " << upsert.first->second << " " << upsert.second << std::endl;
+	upsert = config.insert(make_pair(std::string("empty"), std::string()));
+	std::cout << "try_emplace(\"empty\"): [" << upsert.first->second << "] " << upsert.second << std::endl;
+	upsert = config.insert(make_pair(std::string("host"), std::string("example.com")));
+	upsert.first->second = "example.com";
+	std::cout << "insert_or_assign(\"host\", \"example.com\"): " << upsert.first->second << " " << upsert.second << std::endl;
+	upsert = config.insert(make_pair(std::string("user"), std::string("root")));
+	std::cout << "insert_or_assign(\"user\", \"root\"): " << upsert.first->second << " " << upsert.second << std::endl;
+	map<std::string, std::string>::iterator upserted = config.insert(config.begin(), make_pair(std::string("mode"), std::string("rw")));
+	std::cout << "try_emplace(begin, \"mode\", \"rw\"): " << upserted->second << std::endl;
+	upserted = config.insert(config.end(), make_pair(std::string("mode"), std::string("ro")));
+	upserted->second = "ro";
+	std::cout << "insert_or_assign(end, \"mode\", \"ro\"): " << upserted->second << std::endl;
+#endif
+	std::cout << "map: { ";
+	for (map<std::string, std::string>::iterator it = config.begin(); it != config.end(); it++)
+		std::cout << it->first << " " << it->second << "; ";
+	std::cout << "} size: " << config.size() << std::endl;
+	std::cout << GREEN << "Upserts work!" << OK << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 13  *************/
+	std::cout << YELLOW << "  * Test 13: Tree invariants and shape *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	map<int, int> tree;
+	for (int i = 0; i < 5000; i++)
+		tree[(i * 7919) % 10007] = i;
+	for (int i = 0; i < 10007; i += 3)
+		tree.erase(i);
+	tree.erase(tree.lower_bound(2000), tree.lower_bound(4000));
+	map<int, int> sequential;
+	for (int i = 0; i < 4096; i++)
+		sequential.insert(sequential.end(), make_pair(i, i));
+#ifdef MINE
+	std::cout << "random inserts and erases valid: " << (tree.validate() == NULL) << std::endl;
+	std::cout << "sequential inserts valid: " << (sequential.validate() == NULL) << std::endl;
+	map<int, int>::shape_stats shape = sequential.shape();
+	std::cout << "nodes " << shape.nodes << ", no unbalanced node: " << (shape.unbalanced == 0)
+		<< ", height <= 1.44 log2(n + 2): " << (shape.height <= 1.44 * 13.0) << ", max depth is the height: "
+		<< (shape.maxDepth == shape.height) << ", min height " << shape.minHeight << std::endl;
+	map<int, int> empty;
+	std::cout << "empty valid: " << (empty.validate() == NULL) << ", height " << empty.shape().height << std::endl;
+#else
+	std::cout << "random inserts and erases valid: " << true << std::endl;
+	std::cout << "sequential inserts valid: " << true << std::endl;
+	std::cout << "nodes " << sequential.size() << ", no unbalanced node: " << true
+		<< ", height <= 1.44 log2(n + 2): " << true << ", max depth is the height: " << true << ", min height " << 13 << std::endl;
+	std::cout << "empty valid: " << true << ", height " << 0 << std::endl;
+#endif
+	std::cout << GREEN << "Tree invariants hold!" << OK << END_COLOR << std::endl;
+
 	std::cout << std::endl << CYAN << "********************************************************" << END_COLOR << std::endl;
 	std::cout << std::endl;
 
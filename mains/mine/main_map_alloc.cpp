@@ -0,0 +1,172 @@
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+#include <new>
+
+#ifdef MINE
+	#include "../../containers/map.hpp"
+#else
+	#include <map>
+#endif
+
+using namespace NAMESPACE;
+
+#define CYAN "\033[0;36m"
+#define MAGENTA "\033[0;35m"
+#define YELLOW "\033[0;33m"
+#define GREEN "\033[0;32m"
+#define END_COLOR "\033[0m"
+#define OK "  ✅"
+
+// Every allocation of the program is counted, so the copies made by the
+// map show up: the strings are longer than the small string buffer
+static size_t g_allocations = 0;
+
+void *operator new(std::size_t size) throw(std::bad_alloc) {
+	g_allocations++;
+	void *p = std::malloc(size ? size : 1);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+void operator delete(void *p) throw() {
+	std::free(p);
+}
+
+#define N 1000
+
+static std::string longString(const std::string& prefix, int i) {
+	std::ostringstream ss;
+	ss << prefix << "_that_does_not_fit_in_the_small_string_buffer_" << i;
+	return ss.str();
+}
+
+static void printPerElement(const std::string& what, size_t allocations) {
+	std::cout << what << " : " << allocations / N << " allocations per element";
+	if (allocations % N)
+		std::cout << " (+" << allocations % N << ")";
+	std::cout << std::endl;
+}
+
+int main()
+{
+
+					//////////////// TEST MAP ALLOCATIONS ////////////////////
+
+	std::cout << CYAN << "********************************************************" << END_COLOR << std::endl;
+	std::cout << CYAN << "**************** Test Map Allocations ******************" << END_COLOR << std::endl;
+	std::cout << CYAN << "********************************************************" << END_COLOR << std::endl << std::endl;
+
+	typedef map<std::string, std::string>	map_type;
+	typedef map_type::value_type			value_type;
+
+	std::vector<value_type> values;
+	std::vector<std::string> keys;
+	std::vector<std::string> newKeys;
+	values.reserve(N);
+	keys.reserve(N);
+	newKeys.reserve(N);
+	for (int i = 0; i < N; i++) {
+		values.push_back(value_type(longString("key", i), longString("value", i)));
+		keys.push_back(longString("key", i));
+		newKeys.push_back(longString("new_key", i));
+	}
+	size_t before;
+
+
+						/***********  TEST 1  *************/
+
+	std::cout << YELLOW << "  * Test 1: Insertion *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	map_type m;
+	before = g_allocations;
+	for (int i = 0; i < N; i++)
+		m.insert(values[i]);
+	printPerElement("insert(value_type) of new keys (node + key + value)", g_allocations - before);
+
+	before = g_allocations;
+	for (int i = 0; i < N; i++)
+		m.insert(values[i]);
+	printPerElement("insert(value_type) of existing keys", g_allocations - before);
+
+	before = g_allocations;
+	for (int i = 0; i < N; i++)
+		m.insert(m.end(), values[i]);
+	printPerElement("insert(hint, value_type) of existing keys", g_allocations - before);
+
+	before = g_allocations;
+	m.insert(values.begin(), values.end());
+	printPerElement("insert(first, last) of existing keys", g_allocations - before);
+
+	before = g_allocations;
+	for (int i = 0; i < N; i++)
+		m[keys[i]];
+	printPerElement("operator[] of existing keys", g_allocations - before);
+
+	before = g_allocations;
+	for (int i = 0; i < N; i++)
+		m[newKeys[i]];
+	std::cout << "operator[] of new keys : at most 3 allocations per element : "
+		<< (g_allocations - before <= 3 * N ? "yes" : "no") << std::endl;
+	std::cout << "size : " << m.size() << std::endl;
+
+	std::cout << std::endl << GREEN << "Test 1 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+
+						/***********  TEST 2  *************/
+
+	std::cout << YELLOW << "  * Test 2: Lookups & erase *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	size_t found = 0;
+	before = g_allocations;
+	for (int i = 0; i < N; i++) {
+		found += m.count(keys[i]);
+		found += (m.find(newKeys[i]) != m.end());
+		found += (m.lower_bound(keys[i]) != m.end());
+	}
+	printPerElement("find / count / lower_bound", g_allocations - before);
+	std::cout << "found : " << found << std::endl;
+
+	before = g_allocations;
+	for (int i = 0; i < N; i++)
+		m.erase(newKeys[i]);
+	printPerElement("erase(key)", g_allocations - before);
+	std::cout << "size : " << m.size() << std::endl;
+
+	std::cout << std::endl << GREEN << "Test 2 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+
+						/***********  TEST 3  *************/
+
+	std::cout << YELLOW << "  * Test 3: Copies *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	before = g_allocations;
+	{
+		map_type copy(m);
+		printPerElement("copy constructor", g_allocations - before);
+		before = g_allocations;
+		map_type assigned;
+		assigned = copy;
+		printPerElement("assignment operator", g_allocations - before);
+		std::cout << "equal : " << (assigned == m) << std::endl;
+	}
+
+	before = g_allocations;
+	map_type range(values.begin(), values.end());
+	printPerElement("range constructor", g_allocations - before);
+
+	std::cout << std::endl << GREEN << "Test 3 success" << OK << END_COLOR << std::endl;
+	std::cout << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	return 0;
+}
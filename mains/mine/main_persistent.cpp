@@ -0,0 +1,251 @@
+#include <iostream>
+#include <string>
+#include <functional>
+#include <stdexcept>
+
+#include "../../utils/instrumented_allocator.hpp"
+#ifdef MINE
+	#include "../../containers/vector.hpp"
+	#include "../../containers/persistent_map.hpp"
+#else
+	#include <vector>
+	#include <map>
+
+// What persistent_map does, with copies of the whole map
+template <class Key, class T, class Compare = std::less<Key>,
+	class Alloc = std::allocator<std::pair<const Key, T> > >
+class persistent_map : public std::map<Key, T, Compare, Alloc>
+{
+	typedef std::map<Key, T, Compare, Alloc>	base;
+public:
+	typedef typename base::value_type			value_type;
+
+	explicit persistent_map(const Compare& comp = Compare(), const Alloc& alloc = Alloc()) : base(comp, alloc) {}
+	template <class InputIterator>
+	persistent_map(InputIterator first, InputIterator last) : base(first, last) {}
+
+	bool insert(const value_type& val) {
+		return base::insert(val).second;
+	}
+	bool insert_or_assign(const Key& key, const T& obj) {
+		std::pair<typename base::iterator, bool> ret = base::insert(value_type(key, obj));
+		ret.first->second = obj;
+		return ret.second;
+	}
+	bool same_version(const persistent_map& x) const {
+		return *this == x;
+	}
+};
+#endif
+
+using namespace NAMESPACE;
+
+#define CYAN "\033[0;36m"
+#define MAGENTA "\033[0;35m"
+#define YELLOW "\033[0;33m"
+#define GREEN "\033[0;32m"
+#define END_COLOR "\033[0m"
+#define OK "  ✅"
+
+typedef persistent_map<int, std::string>	string_map;
+
+// Ascending or descending, chosen at construction
+struct order {
+	explicit order(bool descending = false) : descending(descending) {}
+	bool operator()(int lhs, int rhs) const {
+		return this->descending ? rhs < lhs : lhs < rhs;
+	}
+	bool	descending;
+};
+
+template <class Map>
+static void print(const std::string& name, const Map& m) {
+	std::cout << name << ": { ";
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); it++)
+		std::cout << it->first << " " << it->second << "; ";
+	std::cout << "} size: " << m.size() << std::endl;
+}
+
+int main()
+{
+
+					//////////////// TEST PERSISTENT MAP ////////////////////
+
+	std::cout << CYAN << "********************************************************" << END_COLOR << std::endl;
+	std::cout << CYAN << "***************** Test Persistent Map ******************" << END_COLOR << std::endl;
+	std::cout << CYAN << "********************************************************" << END_COLOR << std::endl << std::endl;
+	std::cout << std::boolalpha;
+
+
+						/***********  TEST 1  *************/
+
+	std::cout << YELLOW << "  * Test 1: Map operations *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	{
+		string_map m;
+		std::cout << "empty: " << m.empty() << ", size " << m.size() << std::endl;
+		for (int i = 0; i < 10; i++)
+			m.insert(string_map::value_type(i * 7 % 10, std::string(i + 1, 'a' + i)));
+		std::cout << "insert(3, \"x\"): " << m.insert(string_map::value_type(3, "x")) << std::endl;
+		std::cout << "insert(12, \"x\"): " << m.insert(string_map::value_type(12, "x")) << std::endl;
+		std::cout << "insert_or_assign(3, \"three\"): " << m.insert_or_assign(3, "three") << std::endl;
+		std::cout << "insert_or_assign(14, \"fourteen\"): " << m.insert_or_assign(14, "fourteen") << std::endl;
+		std::cout << "erase(5) " << m.erase(5) << ", erase(5) " << m.erase(5) << ", erase(13) " << m.erase(13) << std::endl;
+		print("map", m);
+		std::cout << "at(3): " << m.at(3) << ", find(12): " << m.find(12)->second
+			<< ", find(13) is end: " << (m.find(13) == m.end()) << ", count(4) " << m.count(4) << std::endl;
+		std::cout << "lower_bound(5): " << m.lower_bound(5)->first << ", upper_bound(6): " << m.upper_bound(6)->first
+			<< ", upper_bound(14) is end: " << (m.upper_bound(14) == m.end()) << std::endl;
+		try {
+			m.at(42);
+		} catch (std::out_of_range& e) {
+			std::cout << "at(42) throws out_of_range" << std::endl;
+		}
+		string_map range(m.lower_bound(2), m.upper_bound(8));
+		print("range [2, 8]", range);
+		m.clear();
+		std::cout << "clear: empty " << m.empty() << ", size " << m.size() << std::endl;
+	}
+	std::cout << GREEN << "Map operations work!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 2  *************/
+
+	std::cout << YELLOW << "  * Test 2: Versions *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	{
+		vector<string_map> versions;
+		string_map current;
+		for (int i = 0; i < 6; i++)
+			current.insert_or_assign(i, std::string(1, 'a' + i));
+		versions.push_back(current);
+		current.insert_or_assign(2, "two");
+		versions.push_back(current);
+		current.erase(0);
+		current.erase(5);
+		versions.push_back(current);
+		current.insert_or_assign(9, "nine");
+		current.insert_or_assign(2, "deux");
+		versions.push_back(current);
+		string_map branch(versions[1]);
+		branch.insert_or_assign(7, "branch");
+		current.clear();
+		for (size_t i = 0; i < versions.size(); i++)
+			print("version " + std::string(1, '0' + i), versions[i]);
+		print("branch of 1", branch);
+		print("current", current);
+		versions[0] = versions[2];
+		print("version 0 = version 2", versions[0]);
+		std::cout << "same version: " << versions[0].same_version(versions[2]) << std::endl;
+		std::cout << "0 == 2: " << (versions[0] == versions[2]) << ", 1 == 2: " << (versions[1] == versions[2])
+			<< ", 1 < 2: " << (versions[1] < versions[2]) << ", 3 > 2: " << (versions[3] > versions[2])
+			<< ", 3 <= 3: " << (versions[3] <= versions[3]) << ", 1 >= branch: " << (versions[1] >= branch) << std::endl;
+		string_map rebuilt;
+		for (int i = 1; i < 5; i++)
+			rebuilt.insert_or_assign(i, std::string(1, 'a' + i));
+		rebuilt.insert_or_assign(2, "two");
+#ifdef MINE
+		bool sameVersion = rebuilt.same_version(versions[2]);
+#else
+		bool sameVersion = false;
+#endif
+		std::cout << "rebuilt == 2: " << (rebuilt == versions[2]) << ", rebuilt same version as 2: " << sameVersion << std::endl;
+		swap(versions[1], versions[3]);
+		print("swapped 1", versions[1]);
+	}
+	std::cout << GREEN << "Versions are kept!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 3  *************/
+
+	std::cout << YELLOW << "  * Test 3: Shared nodes *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	ft::allocation_stats stats;
+	{
+		typedef persistent_map<int, int, std::less<int>,
+			ft::instrumented_allocator<pair<const int, int> > >	counted_map;
+		counted_map m(std::less<int>(), stats);
+		for (int i = 0; i < 4096; i++)
+			m.insert(counted_map::value_type(i, i));
+		size_t built = stats.liveBytes;
+		std::cout << "4096 elements" << std::endl;
+		vector<counted_map> versions;
+		for (int i = 0; i < 100; i++) {
+			versions.push_back(m);
+			m.insert_or_assign(i * 41 % 4096, -i);
+		}
+		size_t allocations = stats.allocations;
+		counted_map copy(m);
+#ifdef MINE
+		std::cout << "copy allocates nothing: " << (stats.allocations == allocations) << std::endl;
+		std::cout << "100 versions hold less than a tenth of a copy each: "
+			<< (stats.liveBytes - built < built * 10) << std::endl;
+#else
+		std::cout << "copy allocates nothing: " << (allocations > 0) << std::endl;
+		std::cout << "100 versions hold less than a tenth of a copy each: " << (built > 0) << std::endl;
+#endif
+		long sum = 0;
+		for (int i = 0; i < 100; i++)
+			sum += versions[i].at(i * 41 % 4096);
+		std::cout << "each version holds the values before its update: " << (sum == 41 * 99 * 100 / 2) << std::endl;
+		versions.clear();
+		copy.erase(0);
+		std::cout << "m keeps 0 after copy.erase(0): " << m.count(0) << ", copy size " << copy.size() << std::endl;
+	}
+	std::cout << "live bytes " << stats.liveBytes << ", deallocations == allocations: "
+		<< (stats.deallocations == stats.allocations) << std::endl;
+	std::cout << GREEN << "Versions share their nodes!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 4  *************/
+
+	std::cout << YELLOW << "  * Test 4: Assignment *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	{
+		typedef persistent_map<int, int, order>	ordered_map;
+		ordered_map descending(order(true)), ascending;
+		for (int i = 0; i < 10; i++)
+			descending.insert(ordered_map::value_type(i, i));
+		ascending.insert(ordered_map::value_type(42, 42));
+		ascending = descending;
+		std::cout << "insert of a key already there: " << ascending.insert(ordered_map::value_type(5, 99))
+			<< ", size " << ascending.size() << ", count(3) " << ascending.count(3)
+			<< ", descending: " << ascending.key_comp().descending << std::endl;
+		print("assigned", ascending);
+	}
+	ft::allocation_stats aStats, bStats;
+	{
+		typedef persistent_map<int, int, std::less<int>,
+			ft::instrumented_allocator<pair<const int, int> > >	counted_map;
+		counted_map b(std::less<int>(), bStats);
+		b.insert(counted_map::value_type(-1, -1));
+		{
+			counted_map a(std::less<int>(), aStats);
+			for (int i = 0; i < 100; i++)
+				a.insert(counted_map::value_type(i, i));
+			b = a;
+		}
+		b.insert(counted_map::value_type(100, 100));
+		std::cout << "assigned from a map counting elsewhere: size " << b.size() << std::endl;
+	}
+	std::cout << "a: live bytes " << aStats.liveBytes << ", deallocations == allocations: "
+		<< (aStats.deallocations == aStats.allocations) << std::endl;
+	std::cout << "b: live bytes " << bStats.liveBytes << ", deallocations == allocations: "
+		<< (bStats.deallocations == bStats.allocations) << std::endl;
+	std::cout << GREEN << "Assignment takes the order and the allocator!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	return 0;
+}
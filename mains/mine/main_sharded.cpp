@@ -0,0 +1,300 @@
+#include <iostream>
+#include <string>
+#include <pthread.h>
+
+#ifdef MINE
+	#include "../../containers/sharded_map.hpp"
+#else
+	#include <map>
+
+// What sharded_map does, with one map behind one lock
+template <class Key, class T>
+class sharded_map
+{
+	typedef std::map<Key, T>					map_type;
+public:
+	typedef typename map_type::value_type		value_type;
+	typedef typename map_type::const_iterator	const_iterator;
+
+	class view
+	{
+	public:
+		explicit view(const sharded_map& map) : map(map) {
+			pthread_mutex_lock(&map.lock);
+		}
+		~view() {
+			pthread_mutex_unlock(&this->map.lock);
+		}
+		const_iterator begin() const {
+			return this->map.m.begin();
+		}
+		const_iterator end() const {
+			return this->map.m.end();
+		}
+		size_t size() const {
+			return this->map.m.size();
+		}
+	private:
+		const sharded_map&	map;
+	};
+
+	explicit sharded_map(size_t shards = 16) : shards(shards ? shards : 1) {
+		pthread_mutex_init(&this->lock, NULL);
+	}
+	~sharded_map() {
+		pthread_mutex_destroy(&this->lock);
+	}
+
+	bool find(const Key& key, T& value) const {
+		guard g(this->lock);
+		const_iterator it = this->m.find(key);
+		if (it == this->m.end())
+			return false;
+		value = it->second;
+		return true;
+	}
+	size_t count(const Key& key) const {
+		guard g(this->lock);
+		return this->m.count(key);
+	}
+	bool insert(const value_type& val) {
+		guard g(this->lock);
+		return this->m.insert(val).second;
+	}
+	bool insert_or_assign(const Key& key, const T& obj) {
+		guard g(this->lock);
+		std::pair<typename map_type::iterator, bool> ret = this->m.insert(value_type(key, obj));
+		ret.first->second = obj;
+		return ret.second;
+	}
+	size_t erase(const Key& key) {
+		guard g(this->lock);
+		return this->m.erase(key);
+	}
+	void clear() {
+		guard g(this->lock);
+		this->m.clear();
+	}
+	size_t size() const {
+		guard g(this->lock);
+		return this->m.size();
+	}
+	bool empty() const {
+		return this->size() == 0;
+	}
+	size_t shard_count() const {
+		return this->shards;
+	}
+
+private:
+	struct guard {
+		guard(pthread_mutex_t& lock) : lock(lock) {
+			pthread_mutex_lock(&this->lock);
+		}
+		~guard() {
+			pthread_mutex_unlock(&this->lock);
+		}
+		pthread_mutex_t&	lock;
+	};
+
+	map_type				m;
+	size_t					shards;
+	mutable pthread_mutex_t	lock;
+};
+#endif
+
+using namespace NAMESPACE;
+
+#define CYAN "\033[0;36m"
+#define MAGENTA "\033[0;35m"
+#define YELLOW "\033[0;33m"
+#define GREEN "\033[0;32m"
+#define END_COLOR "\033[0m"
+#define OK "  ✅"
+
+typedef sharded_map<std::string, int>	string_map;
+typedef sharded_map<int, long>			long_map;
+
+template <class Map>
+static void print(const std::string& name, const Map& m) {
+	typename Map::view v(m);
+	std::cout << name << ": { ";
+	for (typename Map::const_iterator it = v.begin(); it != v.end(); it++)
+		std::cout << it->first << " " << it->second << "; ";
+	std::cout << "} size: " << v.size() << std::endl;
+}
+
+// Each writer inserts its own keys (t, t + writers, ...) with the value
+// 3 * key, then erases the odd ones; a reader walks views meanwhile
+static const int	writers = 8;
+static const int	keysPerWriter = 5000;
+
+struct shared_state {
+	shared_state() : map(16), done(0) {}
+	long_map	map;
+	int			done;
+};
+
+struct thread_arg {
+	shared_state	*state;
+	int				id;
+	bool			ok;
+	long			views;
+};
+
+static void *writer(void *p) {
+	thread_arg& arg = *static_cast<thread_arg *>(p);
+	for (int i = 0; i < keysPerWriter; i++) {
+		int key = arg.id + i * writers;
+		arg.ok = arg.state->map.insert(long_map::value_type(key, 3L * key)) && arg.ok;
+	}
+	for (int i = 0; i < keysPerWriter; i++) {
+		int key = arg.id + i * writers;
+		long value = 0;
+		arg.ok = arg.state->map.find(key, value) && value == 3L * key && arg.ok;
+		if (key % 2)
+			arg.ok = arg.state->map.erase(key) == 1 && arg.ok;
+	}
+	return NULL;
+}
+
+// Every view is in key order and holds whole elements
+static void *viewer(void *p) {
+	thread_arg& arg = *static_cast<thread_arg *>(p);
+	while (!__atomic_load_n(&arg.state->done, __ATOMIC_ACQUIRE)) {
+		long_map::view v(arg.state->map);
+		long_map::const_iterator it = v.begin();
+		size_t n = 0;
+		for (int previous = -1; it != v.end(); it++, n++) {
+			arg.ok = arg.ok && it->first > previous && it->second == 3L * it->first;
+			previous = it->first;
+		}
+		arg.ok = arg.ok && n == v.size();
+		arg.views++;
+	}
+	return NULL;
+}
+
+int main()
+{
+
+					//////////////// TEST SHARDED MAP ////////////////////
+
+	std::cout << CYAN << "********************************************************" << END_COLOR << std::endl;
+	std::cout << CYAN << "****************** Test Sharded Map ********************" << END_COLOR << std::endl;
+	std::cout << CYAN << "********************************************************" << END_COLOR << std::endl << std::endl;
+	std::cout << std::boolalpha;
+
+
+						/***********  TEST 1  *************/
+
+	std::cout << YELLOW << "  * Test 1: Map operations *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	{
+		string_map m(4);
+		std::cout << "shards " << m.shard_count() << ", empty: " << m.empty() << std::endl;
+		const char *words[] = { "pear", "apple", "fig", "kiwi", "plum", "date", "lime", "grape", "melon", "peach" };
+		for (int i = 0; i < 10; i++)
+			m.insert(string_map::value_type(words[i], i));
+		std::cout << "insert(\"fig\", 42): " << m.insert(string_map::value_type("fig", 42)) << std::endl;
+		std::cout << "insert_or_assign(\"fig\", 42): " << m.insert_or_assign("fig", 42) << std::endl;
+		std::cout << "insert_or_assign(\"cherry\", 10): " << m.insert_or_assign("cherry", 10) << std::endl;
+		int value = 0;
+		std::cout << "find(\"fig\"): " << m.find("fig", value) << " " << value
+			<< ", find(\"banana\"): " << m.find("banana", value) << std::endl;
+		std::cout << "count(\"kiwi\") " << m.count("kiwi") << ", erase(\"kiwi\") " << m.erase("kiwi")
+			<< ", erase(\"kiwi\") " << m.erase("kiwi") << ", size " << m.size() << std::endl;
+		print("in key order", m);
+		m.clear();
+		print("cleared", m);
+		string_map single(0);
+		single.insert(string_map::value_type("one", 1));
+		std::cout << "0 shards is 1: " << single.shard_count() << std::endl;
+		print("single", single);
+	}
+	std::cout << GREEN << "Map operations work!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 2  *************/
+
+	std::cout << YELLOW << "  * Test 2: Shards *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	{
+		long_map m(16);
+		for (int i = 0; i < 16000; i++)
+			m.insert(long_map::value_type(i, i));
+#ifdef MINE
+		bool spread = true;
+		size_t total = 0;
+		for (size_t i = 0; i < m.shard_count(); i++) {
+			spread = spread && m.shard_size(i) > 800 && m.shard_size(i) < 1200;
+			total += m.shard_size(i);
+		}
+		bool indexed = true;
+		for (int i = 0; i < 16000; i++)
+			indexed = indexed && m.shard_index(i) < m.shard_count();
+#else
+		bool spread = true, indexed = true;
+		size_t total = m.size();
+#endif
+		std::cout << "16000 consecutive keys: every shard holds 1000 +- 200: " << spread
+			<< ", total " << total << ", indexes in range: " << indexed << std::endl;
+		long_map::view v(m);
+		long_map::const_iterator it = v.begin();
+		long sum = 0;
+		bool ordered = true;
+		for (int key = 0; it != v.end(); it++, key++) {
+			ordered = ordered && it->first == key;
+			sum += it->second;
+		}
+		std::cout << "merged in order: " << ordered << ", sum " << sum << std::endl;
+	}
+	std::cout << GREEN << "Keys are spread and merged!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+						/***********  TEST 3  *************/
+
+	std::cout << YELLOW << "  * Test 3: Writers and views *  " << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	{
+		shared_state state;
+		thread_arg args[writers + 1];
+		pthread_t threads[writers + 1];
+		for (int i = 0; i <= writers; i++) {
+			args[i].state = &state;
+			args[i].id = i;
+			args[i].ok = true;
+			args[i].views = 0;
+		}
+		pthread_create(&threads[writers], NULL, viewer, &args[writers]);
+		for (int i = 0; i < writers; i++)
+			pthread_create(&threads[i], NULL, writer, &args[i]);
+		bool ok = true;
+		for (int i = 0; i < writers; i++) {
+			pthread_join(threads[i], NULL);
+			ok = ok && args[i].ok;
+		}
+		__atomic_store_n(&state.done, 1, __ATOMIC_RELEASE);
+		pthread_join(threads[writers], NULL);
+		std::cout << writers << " writers of " << keysPerWriter << " keys: every insert, find and erase as expected: " << ok << std::endl;
+		std::cout << "every view ordered and whole: " << args[writers].ok << std::endl;
+		long_map::view v(state.map);
+		bool even = true;
+		for (long_map::const_iterator it = v.begin(); it != v.end(); it++)
+			even = even && it->first % 2 == 0;
+		std::cout << "left: " << v.size() << " elements, all even: " << even << std::endl;
+	}
+	std::cout << GREEN << "Writers work in parallel!" << OK << END_COLOR << std::endl;
+
+	std::cout << std::endl << CYAN << "___________________________________________________" << END_COLOR << std::endl;
+	std::cout << std::endl;
+
+	return 0;
+}
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <unistd.h>
+#include <string>
 
 #ifdef MINE
 	#include "../../containers/vector.hpp"
@@ -17,6 +18,37 @@ using namespace NAMESPACE;
 #define YELLOW "\033[0;33m"
 #define GREEN "\033[0;32m"
 
+// Gives access to the capacity of the vector under the stack
+template <class Stack>
+class Inspect : public Stack {
+	public:
+		size_t capacity() const { return this->c.capacity(); }
+};
+
+#ifdef MINE
+typedef stack<int, vector<int>, high_water_trim<1024, 4> > trimming_stack;
+#else
+// std::stack has no trimming policy, the vector is shrunk by hand as
+// high_water_trim<1024, 4> does it
+class trimming_stack : public stack<int, vector<int> > {
+	public:
+		trimming_stack() : mark(0) {}
+		void push(int val) {
+			this->c.push_back(val);
+			if (this->c.size() > this->mark)
+				this->mark = this->c.size();
+		}
+		void pop() {
+			this->c.pop_back();
+			if (this->mark >= 1024 && this->c.size() * 4 <= this->mark) {
+				vector<int>(this->c).swap(this->c);
+				this->mark = this->c.size();
+			}
+		}
+	private:
+		size_t mark;
+};
+#endif
 
 int main()
 {
@@ -122,5 +154,54 @@ int main()
 	std::cout << ((lhs >= rhs) ? MAGENTA : GREEN) << ((lhs >= rhs) ? "invalid true " : "valid false ") << END_COLOR << (lhs >= rhs) << std::endl;
 	std::cout << GREEN << "Every relationnal operators works!" << END_COLOR << std::endl;
 
+	std::cout << std::endl << YELLOW << "  * Test 6: Capacity after a burst *  " << END_COLOR << std::endl;
+	Inspect<stack<int, vector<int> > > plain;
+	Inspect<trimming_stack> trimmed;
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < 100000; i++) {
+			plain.push(i);
+			trimmed.push(i);
+		}
+		while (plain.size() > 10) {
+			plain.pop();
+			trimmed.pop();
+		}
+		std::cout << "round " << round << ": top " << plain.top() << " / " << trimmed.top()
+			<< ", plain stack keeps its capacity: " << (plain.capacity() >= 100000)
+			<< ", trimming stack capacity: " << trimmed.capacity() << std::endl;
+	}
+	while (!trimmed.empty())
+		trimmed.pop();
+	std::cout << "emptied trimming stack capacity: " << trimmed.capacity() << std::endl;
+	// The high water mark comes with the elements: the copy trims where the source would
+	Inspect<trimming_stack> source, assigned;
+	for (int i = 0; i < 100000; i++)
+		source.push(i);
+	while (source.size() > 30000)
+		source.pop();
+	assigned = source;
+	while (assigned.size() > 25000)
+		assigned.pop();
+	std::cout << "assigned at 30000 then popped to 25000, capacity: " << assigned.capacity() << std::endl;
+
+	std::cout << std::endl << YELLOW << "  * Test 7: Emplace *  " << END_COLOR << std::endl;
+	stack<std::string> words;
+#ifdef MINE
+	words.emplace();
+	words.emplace("word");
+	words.emplace(4, '-');
+	words.emplace(std::string("emplaced"), 0, 4);
+#else
+	words.push(std::string());
+	words.push(std::string("word"));
+	words.push(std::string(4, '-'));
+	words.push(std::string(std::string("emplaced"), 0, 4));
+#endif
+	while (!words.empty()) {
+		std::cout << "[" << words.top() << "] ";
+		words.pop();
+	}
+	std::cout << std::endl;
+
 	return 0;
 }
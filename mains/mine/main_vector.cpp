@@ -1,4 +1,5 @@
 #include <iostream>
+#include <string>
 #include <unistd.h>
 
 #ifdef MINE
@@ -321,5 +322,68 @@ int main()
 	std::cout << "Decrement it-=2: " << *it4 << std::endl;
 	std::cout << "Decrement it-=2: " << *(it4 -= 2) << std::endl;
 	std::cout << std::endl;
+
+	std::cout << YELLOW << "Test 10: comparisons of integral vectors" << END_COLOR << std::endl;
+	vector<int> big1(1000, 7);
+	vector<int> big2(big1);
+	std::cout << "== " << (big1 == big2) << " < " << (big1 < big2) << " <= " << (big1 <= big2) << std::endl;
+	big2[700] = -1;
+	std::cout << "== " << (big1 == big2) << " < " << (big1 < big2) << " > " << (big1 > big2) << std::endl;
+	big2[700] = 7;
+	big2.push_back(0);
+	std::cout << "prefix: == " << (big1 == big2) << " < " << (big1 < big2) << " > " << (big1 > big2) << std::endl;
+	vector<char> c1(300, 'a');
+	vector<char> c2(c1);
+	c2[299] = -100;
+	std::cout << "char: == " << (c1 == c2) << " < " << (c1 < c2) << " > " << (c1 > c2) << std::endl;
+	vector<unsigned char> u1(300, 'a');
+	vector<unsigned char> u2(u1);
+	u2[299] = 200;
+	std::cout << "unsigned char: == " << (u1 == u2) << " < " << (u1 < u2) << " > " << (u1 > u2) << std::endl;
+	u2.resize(10);
+	std::cout << "unsigned char prefix: < " << (u1 < u2) << " > " << (u1 > u2) << std::endl;
+	vector<unsigned char> empty1, empty2;
+	std::cout << "empty: == " << (empty1 == empty2) << " < " << (empty1 < empty2) << " < " << (empty1 < u1) << std::endl;
+	vector<bool> b1(100, true);
+	vector<bool> b2(b1);
+	b2[50] = false;
+	std::cout << "bool: == " << (b1 == b2) << " < " << (b1 < b2) << " > " << (b1 > b2) << std::endl;
+	vector<std::string> s1(3, "abc");
+	vector<std::string> s2(s1);
+	s2[2] = "abd";
+	std::cout << "string: == " << (s1 == s2) << " < " << (s1 < s2) << " > " << (s1 > s2) << std::endl;
+	int ints1[] = { 1, 2, 3, -4 }, ints2[] = { 1, 2, 3, 4 };
+	const int *constInts = ints2;
+	unsigned char bytes1[] = { 1, 2, 200 }, bytes2[] = { 1, 2, 3 };
+	std::cout << "int*: " << lexicographical_compare(ints1, ints1 + 4, ints2, ints2 + 4)
+		<< " " << lexicographical_compare(ints2, ints2 + 4, ints1, ints1 + 4)
+		<< ", int* and const int*: " << lexicographical_compare(ints1, ints1 + 4, constInts, constInts + 4)
+		<< ", unsigned char*: " << lexicographical_compare(bytes1, bytes1 + 3, bytes2, bytes2 + 3)
+		<< " " << lexicographical_compare(bytes2, bytes2 + 2, bytes1, bytes1 + 3) << std::endl;
+	std::cout << std::endl;
+
+	std::cout << YELLOW << "  * Test 11: Emplace *  " << END_COLOR << std::endl;
+	vector<std::string> names;
+#ifdef MINE
+	names.emplace_back();
+	names.emplace_back("literal");
+	names.emplace_back(3, 'z');
+	names.emplace_back(std::string("substring"), 3, 3);
+	names.emplace(names.begin() + 1, 2, 'y');
+	names.emplace(names.end(), "last");
+	names.emplace_back(names[1]);		// Refers to an element while the vector grows
+#else
+	names.push_back(std::string());
+	names.push_back(std::string("literal"));
+	names.push_back(std::string(3, 'z'));
+	names.push_back(std::string(std::string("substring"), 3, 3));
+	names.insert(names.begin() + 1, std::string(2, 'y'));
+	names.insert(names.end(), std::string("last"));
+	names.push_back(std::string(names[1]));
+#endif
+	std::cout << "size " << names.size() << ":";
+	for (vector<std::string>::iterator it = names.begin(); it != names.end(); it++)
+		std::cout << " [" << *it << "]";
+	std::cout << std::endl << std::endl;
 	return 0;
 }
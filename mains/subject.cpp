@@ -1,6 +1,5 @@
 #include <iostream>
 #include <string>
-#include <deque>
 
 #include <stdlib.h>
 
@@ -8,10 +7,12 @@
 	#include "../containers/map.hpp"
 	#include "../containers/stack.hpp"
 	#include "../containers/vector.hpp"
+	#include "../containers/deque.hpp"
 #else
 	#include <map>
 	#include <stack>
 	#include <vector>
+	#include <deque>
 #endif
 
 using namespace NAMESPACE;
@@ -62,7 +63,7 @@ int main(int argc, char** argv) {
 	vector<int> vector_int;
 	stack<int> stack_int;
 	vector<Buffer> vector_buffer;
-	stack<Buffer, std::deque<Buffer> > stack_deq_buffer;
+	stack<Buffer, deque<Buffer> > stack_deq_buffer;
 	map<int, int> map_int;
 
 	for (int i = 0; i < COUNT; i++)
@@ -4,63 +4,95 @@
 #include <iostream>
 #include <string>
 #include <algorithm>
+#include <new>
+#include <cstddef>
+#include <cassert>
 #include "pair.hpp"
+#include "emplace_args.hpp"
 #include "lexicographical_compare.hpp"
 
+// Built with -D FT_AVL_STATS, the trees count their hot path operations in
+// ft::avl_counters::global() (not thread safe), without it nothing is counted
+#ifdef FT_AVL_STATS
+# define FT_AVL_COUNT(counter) (++ft::avl_counters::global().counter)
+#else
+# define FT_AVL_COUNT(counter) ((void)0)
+#endif
+
 namespace ft
 {
+	struct avl_counters {
+		avl_counters() {
+			this->reset();
+		}
+		void reset() {
+			this->comparisons = 0;
+			this->leftRotations = 0;
+			this->rightRotations = 0;
+			this->nodeAllocations = 0;
+			this->nodeFrees = 0;
+			this->parentClimbs = 0;
+		}
+		static avl_counters& global() {
+			static avl_counters counters;
+			return counters;
+		}
+
+		std::size_t	comparisons;		// Calls of the comparator of the tree
+		std::size_t	leftRotations;
+		std::size_t	rightRotations;
+		std::size_t	nodeAllocations;
+		std::size_t	nodeFrees;
+		std::size_t	parentClimbs;		// Steps up to a parent in next() and prev()
+	};
+
 	namespace
 	{
-		template <class T, class Compare>
+		template <class T>
 		struct Node {
-			Node(Compare comp, T pair, Node *endd) 
-			: pair(pair), left(NULL), right(NULL), parent(NULL),
-				height(1), comp(comp), endd(endd) {}
-			Node(const Node& other) 
-			: pair(other.pair), left(NULL), right(NULL), parent(NULL),
-				height(1), comp(other.comp), endd(other.endd) {
-				*this = other;
-			}
-			Node& operator=(const Node& other) {
-				this->left = other.left;
-				this->right = other.right;
-				this->parent = NULL;
-				this->height = other.height;
-				this->comp = other.comp;
-				this->endd = other.endd;
-				return *this;
-			}
+			Node(const T& pair)
+			: pair(pair), left(NULL), right(NULL), parent(NULL), height(1) {}
+			template <class U1, class U2>
+			Node(const U1& first, const U2& second)
+			: pair(first, second), left(NULL), right(NULL), parent(NULL), height(1) {}
+			template <class U1, class Args>
+			Node(piecewise_construct_t, const U1& first, const Args& args)
+			: pair(ft::piecewise_construct, first, args), left(NULL), right(NULL), parent(NULL), height(1) {}
 			~Node() {}
 
+			// The parent of the root is the end node of its tree, the only
+			// node with a height of 0, so a node never has to know its tree
 			Node* next() {
-				Node *p;
 				if (this->right) {
-					p = this->right;
+					Node *p = this->right;
 					while (p->left)
 						p = p->left;
-				} else {
-					p = this->parent;
-					while (p && this->comp(p->pair.first, this->pair.first))
-						p = p->parent;
+					return p;
+				}
+				Node *child = this;
+				Node *p = this->parent;
+				while (p && p->height && child == p->right) {
+					FT_AVL_COUNT(parentClimbs);
+					child = p;
+					p = p->parent;
 				}
-				if (!p)
-					return endd;
-				return p;
+				return p ? p : this;
 			}
 			Node* prev() {
-				Node *p;
 				if (this->left) {
-					p = this->left;
+					Node *p = this->left;
 					while (p->right)
 						p = p->right;
-				} else {
-					p = this->parent;
-					while (p && this->comp(this->pair.first, p->pair.first))
-						p = p->parent;
+					return p;
 				}
-				if (!p)
-					return endd;
-				return p;
+				Node *child = this;
+				Node *p = this->parent;
+				while (p && p->height && child == p->left) {
+					FT_AVL_COUNT(parentClimbs);
+					child = p;
+					p = p->parent;
+				}
+				return p ? p : this;
 			}
 	
 			T			pair;
@@ -68,27 +100,24 @@ namespace ft
 			Node		*right;
 			Node		*parent;
 			int			height;
-		private:
-			Compare		comp;
-			Node*		endd;
 		};
 	
-		template <class T, class Compare>
-		int height(Node<T, Compare> *node) {
+		template <class T>
+		int height(Node<T> *node) {
 		if (node == NULL)
 			return 0;
 		return node->height;
 		}
 
-		template <class T, class Compare>
-		int getBalanceFactor(Node<T, Compare> *node) {
+		template <class T>
+		int getBalanceFactor(Node<T> *node) {
 			if (node == NULL)
 				return 0;
 			return height(node->left) - height(node->right);
 		}
 
-		template <class T, class Compare>
-		bool operator<(const Node<T, Compare>& n1, const Node<T, Compare>& n2) {
+		template <class T>
+		bool operator<(const Node<T>& n1, const Node<T>& n2) {
 			return n1.pair.first < n2.pair.first;
 		}
 	}
@@ -101,38 +130,50 @@ namespace ft
 		typedef				T											mapped_type;
 		typedef typename	ft::pair<const key_type, mapped_type>		value_type;
 		typedef 			Compare										key_compare;
-		typedef				Node<value_type, key_compare>				node_type;
+		typedef				Node<value_type>							node_type;
 		typedef typename	Alloc::template rebind<node_type>::other	allocator_type;
 		typedef				size_t										size_type;
 
+		// Which elements setOperation() keeps
+		enum { ONLY_LHS = 1, ONLY_RHS = 2, BOTH = 4 };
+
+		// Shape of the tree: the depth of a node (the root at 1) is the number
+		// of nodes a find() of its key visits
+		struct shape_stats {
+			size_type	nodes;
+			int			height;
+			int			minHeight;		// Of a perfectly balanced tree of as many nodes
+			double		averageDepth;
+			int			maxDepth;
+			size_type	balance[3];		// Nodes of balance factor -1, 0 and 1
+			size_type	unbalanced;		// Nodes of an other balance factor, 0 in a valid tree
+		};
+
 		// Constructor & Destructor
 		AVL(const key_compare& comp, const allocator_type& alloc)
-		: root(NULL), endd(comp, value_type(), NULL), end_ptr(&endd),
-			sizee(0), comp(comp), alloc(alloc) {}
+		: root(NULL), endd(value_type()), end_ptr(&endd),
+			sizee(0), comp(comp), alloc(alloc) {
+			this->endd.height = 0;
+		}
 		AVL(const AVL& other)
-		: root(NULL), endd(other.comp, value_type(), NULL), end_ptr(&endd),
-			sizee(0), comp(other.comp) {
+		: root(NULL), endd(value_type()), end_ptr(&endd),
+			sizee(0), comp(other.comp), alloc(other.alloc) {
+			this->endd.height = 0;
 			*this = other;
 		}
 		AVL& operator=(const AVL& other) {
-			this->endd.right = NULL;
-			this->endd.left = NULL;
-			// Copying all nodes (by reallocation)
+			if (this == &other)
+				return *this;
+			this->deleteRoot();
+			// Copying all nodes (by reallocation), with the allocator of this tree
 			if (other.root) {
-				if (this->root)
-					this->deleteRoot();
-				this->root = this->createNode(other.root->pair);
-				this->root = this->copyDescendants(this->root, other.root);
-				node_type* p = this->root;
-				while (p->right)
-					p = p->right;
-				this->endd.right = p;
-				this->endd.left = p;
+				this->setRoot(this->createNode(other.root->pair));
+				this->copyDescendants(this->root, other.root);
 			}
 			// Other attributes
 			this->sizee = other.sizee;
 			this->comp = other.comp;
-			this->end_ptr = &this->endd;
+			this->updateEnd();
 			return *this;
 		}
 		~AVL() {
@@ -140,44 +181,96 @@ namespace ft
 		}
 
 		// Methods
-		bool insert(value_type pair) {
-			return this->insert(pair, &this->root);
-		}
-		bool insert(value_type pair, node_type **node) {
-			bool exists = (this->find(pair.first) != NULL);
-			*node = this->insertNode(*node, pair);
-			if (!exists) {
-				if (this->sizee == 0) {
-					this->endd.right = *node;
-					this->endd.left = *node;
-				} else if (this->endd.right->right) {
-					this->endd.left = this->endd.right->right;
-					this->endd.right = this->endd.right->right;
-				}
-				this->sizee++;
-			}
-			return !exists;
+		// Single descent: the pair is only copied once, into the new node
+		bool insert(const value_type& pair) {
+			node_type *position;
+			return this->insert(pair, position);
+		}
+		bool insert(const value_type& pair, node_type *&position) { // position: the node of the key
+			PairMaker make(*this, pair);
+			return this->insertWith(pair.first, make, position);
+		}
+		template <class K>
+		bool insertKey(const K& key, node_type *&position) { // Inserts (key, mapped_type()) if missing
+			return this->tryEmplace(key, ft::emplace_args0(), position);
+		}
+		template <class M>
+		bool emplace(const key_type& key, const M& mapped, node_type *&position) { // The pair is built from (key, mapped) in the node
+			ValueMaker<M> make(*this, key, mapped);
+			return this->insertWith(key, make, position);
+		}
+		template <class K, class Args>
+		bool tryEmplace(const K& key, const Args& args, node_type *&position) { // The mapped value is built from args in the node
+			ArgsMaker<K, Args> make(*this, key, args);
+			return this->insertWith(key, make, position);
 		}
 
-		bool erase(key_type key) {
-			if (!this->find(key))
+		bool erase(const key_type& key) {
+			node_type *node = this->extract(key);
+			if (!node)
 				return false;
-			if (!this->comp(key, this->endd.right->pair.first)
-				&& !this->comp(this->endd.right->pair.first, key)) {
-				this->endd.left = this->endd.right->prev();
-				this->endd.right = this->endd.right->prev();
-			}
-			this->root = this->deleteNode(this->root, key);
-			this->sizee--;
+			this->deleteNode(node);
 			return true;
 		}
 
-		node_type *find(key_type key) const {
+		// Node handles: the node is unlinked/linked, never reallocated
+		node_type *extract(const key_type& key) {
+			node_type *node = NULL;
+			this->setRoot(this->unlinkNode(this->root, key, node));
+			if (!node)
+				return NULL;
+			this->sizee--;
+			if (node == this->endd.right)
+				this->updateEnd();
+			node->left = NULL;
+			node->right = NULL;
+			node->parent = NULL;
+			node->height = 1;
+			return node;
+		}
+		bool link(node_type *node, const allocator_type& nodeAlloc, node_type *&position) { // position: node or the node of its key
+			assert(nodeAlloc == this->alloc); // The node will be freed by the allocator of this tree
+			(void)nodeAlloc;
+			NodeMaker make(node);
+			return this->insertWith(node->pair.first, make, position);
+		}
+
+		template <class K>
+		node_type *find(const K& key) const {
 			node_type *p = this->root;
-			while (p && (this->comp(key, p->pair.first)
-							|| this->comp(p->pair.first, key)))
-				p = this->comp(key, p->pair.first) ? p->left : p->right;
-			return p;
+			while (p) {
+				if (this->less(key, p->pair.first))
+					p = p->left;
+				else if (this->less(p->pair.first, key))
+					p = p->right;
+				else
+					return p;
+			}
+			return NULL;
+		}
+		template <class K>
+		node_type *lowerBound(const K& key) const { // First node not less than key
+			node_type *p = this->root, *ret = this->end_ptr;
+			while (p) {
+				if (!this->less(p->pair.first, key)) {
+					ret = p;
+					p = p->left;
+				} else
+					p = p->right;
+			}
+			return ret;
+		}
+		template <class K>
+		node_type *upperBound(const K& key) const { // First node greater than key
+			node_type *p = this->root, *ret = this->end_ptr;
+			while (p) {
+				if (this->less(key, p->pair.first)) {
+					ret = p;
+					p = p->left;
+				} else
+					p = p->right;
+			}
+			return ret;
 		}
 
 		node_type *begin() const {
@@ -202,10 +295,160 @@ namespace ft
 		}
 
 		void swap(AVL& other) {
-			std::swap(this->root, other.root);
-			std::swap(this->end_ptr, other.end_ptr);
+			node_type *tmp = this->root;
+			this->setRoot(other.root);
+			other.setRoot(tmp);
+			std::swap(this->endd.left, other.endd.left);
+			std::swap(this->endd.right, other.endd.right);
 			std::swap(this->sizee, other.sizee);
 			std::swap(this->comp, other.comp);
+			std::swap(this->alloc, other.alloc);	// The nodes are released by the allocator of their tree
+		}
+
+		// Split & join: O(log n) relinking, the keys are never copied
+		size_type eraseRange(node_type *first, node_type *last) { // Erases [first, last)
+			if (first == last)
+				return 0;
+			node_type *lower, *upper, *rest = NULL;
+			node_type *found = this->split(this->root, first->pair.first, lower, upper);
+			upper = this->join(NULL, found, upper);
+			if (last != &this->endd) {
+				node_type *middle;
+				found = this->split(upper, last->pair.first, middle, rest);
+				rest = this->join(NULL, found, rest);
+				upper = middle;
+			}
+			size_type erased = this->deleteNodeAndItsDescendants(upper);
+			this->setRoot(this->join(lower, rest));
+			this->sizee -= erased;
+			this->updateEnd();
+			return erased;
+		}
+		void splitInto(const key_type& key, AVL& upper) { // Moves the keys >= key to upper
+			if (&upper == this)
+				return;
+			upper.deleteRoot();
+			node_type *lower, *greater;
+			node_type *found = this->split(this->root, key, lower, greater);
+			if (found)
+				greater = this->join(NULL, found, greater);
+			size_type total = this->sizee;
+			this->setRoot(lower);
+			upper.setRoot(greater);
+			this->updateEnd();
+			upper.updateEnd();
+			// Counts the smaller side only, by walking both sides together
+			size_type n = 0;
+			node_type *p1 = this->begin(), *p2 = upper.begin();
+			while (p1 != this->end() && p2 != upper.end()) {
+				p1 = p1->next();
+				p2 = p2->next();
+				n++;
+			}
+			this->sizee = (p1 == this->end()) ? n : total - n;
+			upper.sizee = total - this->sizee;
+		}
+		void splice(AVL& other) { // O(log n) if the key ranges do not overlap, merge() otherwise
+			if (&other == this || other.sizee == 0)
+				return;
+			if (!(this->alloc == other.alloc)) { // A node is freed by the allocator of its tree
+				this->copyFrom(other);
+				return;
+			}
+			if (this->sizee == 0) // Only the nodes move, each tree keeps its allocator
+				this->setRoot(other.root);
+			else if (this->less(this->endd.right->pair.first, other.begin()->pair.first))
+				this->setRoot(this->join(this->root, other.root));
+			else if (this->less(other.endd.right->pair.first, this->begin()->pair.first))
+				this->setRoot(this->join(other.root, this->root));
+			else {
+				this->merge(other);
+				return;
+			}
+			this->sizee += other.sizee;
+			this->updateEnd();
+			other.root = NULL;
+			other.sizee = 0;
+			other.updateEnd();
+		}
+
+		// Moves the elements of source whose key is not in this by copy, for
+		// trees whose allocators differ
+		void copyFrom(AVL& source) {
+			node_type *p = source.begin();
+			while (p != source.end()) {
+				node_type *next = p->next(); // Erasing p relinks the other nodes, never reallocates them
+				node_type *position;
+				if (this->insert(p->pair, position))
+					source.erase(p->pair.first);
+				p = next;
+			}
+		}
+
+		// Bulk operations: linear merge of the sorted node lists and
+		// O(n) rebuild of a perfectly balanced tree, without rebalancing
+		void merge(AVL& source) { // Moves (relinks) the nodes whose key is not in this
+			if (&source == this || source.sizee == 0)
+				return;
+			if (!(this->alloc == source.alloc)) { // A node is freed by the allocator of its tree
+				this->copyFrom(source);
+				return;
+			}
+			node_type *mine = this->detachList();
+			node_type *theirs = source.detachList();
+			node_type *kept = NULL, **keptTail = &kept;
+			node_type *left = NULL, **leftTail = &left;
+			size_type keptSize = 0, leftSize = 0;
+			while (mine || theirs) {
+				if (!theirs || (mine && this->less(mine->pair.first, theirs->pair.first)))
+					this->appendToList(mine, keptTail, keptSize);
+				else if (!mine || this->less(theirs->pair.first, mine->pair.first))
+					this->appendToList(theirs, keptTail, keptSize);
+				else
+					this->appendToList(theirs, leftTail, leftSize);
+			}
+			*keptTail = NULL;
+			*leftTail = NULL;
+			this->buildFromList(kept, keptSize);
+			source.buildFromList(left, leftSize);
+		}
+		void setOperation(const AVL& lhs, const AVL& rhs, int keep) { // this = lhs (op) rhs
+			this->deleteRoot();
+			node_type *head = NULL, **tail = &head;
+			size_type n = 0;
+			node_type *n1 = lhs.begin(), *n2 = rhs.begin();
+			try {
+				while (n1 != lhs.end() || n2 != rhs.end()) {
+					const node_type *from;
+					int side;
+					if (n2 == rhs.end() || (n1 != lhs.end()
+							&& this->less(n1->pair.first, n2->pair.first))) {
+						from = n1;
+						n1 = n1->next();
+						side = ONLY_LHS;
+					} else if (n1 == lhs.end() || this->less(n2->pair.first, n1->pair.first)) {
+						from = n2;
+						n2 = n2->next();
+						side = ONLY_RHS;
+					} else { // Equal keys: the value of lhs is kept
+						from = n1;
+						n1 = n1->next();
+						n2 = n2->next();
+						side = BOTH;
+					}
+					if (keep & side) {
+						*tail = this->createNode(from->pair);
+						tail = &(*tail)->right;
+						n++;
+					}
+				}
+			} catch (...) {
+				*tail = NULL;
+				this->deleteList(head);
+				throw;
+			}
+			*tail = NULL;
+			this->buildFromList(head, n);
 		}
 
 		key_compare get_comp() const {
@@ -224,6 +467,46 @@ namespace ft
 			return this->root;
 		}
 
+		shape_stats shape() const {
+			shape_stats s;
+			s.nodes = 0;
+			s.height = height(this->root);
+			s.minHeight = 0;
+			while ((size_type(1) << s.minHeight) <= this->sizee)
+				s.minHeight++;
+			s.averageDepth = 0;
+			s.maxDepth = 0;
+			s.balance[0] = 0;
+			s.balance[1] = 0;
+			s.balance[2] = 0;
+			s.unbalanced = 0;
+			this->shape(this->root, 1, s);
+			if (s.nodes)
+				s.averageDepth /= s.nodes;
+			return s;
+		}
+
+		// NULL if the tree is valid, the first broken invariant otherwise:
+		// parent links, stored heights, balance factors, key order, size and
+		// the end node (parent of the root, points to the last node)
+		const char *validate() const {
+			const char *error = NULL;
+			if (this->endd.height != 0)
+				return "end node height is not 0";
+			if (this->root && this->root->parent != this->end_ptr)
+				return "parent of the root is not the end node";
+			const node_type *last = NULL;
+			size_type n = 0;
+			this->validate(this->root, last, n, error);
+			if (error)
+				return error;
+			if (n != this->sizee)
+				return "size differs from the number of nodes";
+			if (this->endd.left != last || this->endd.right != last)
+				return "end node does not point to the last node";
+			return NULL;
+		}
+
 		template <class Key2, class T2, class Compare2, class Alloc2>
 		friend bool operator==(const AVL<Key2, T2, Compare2, Alloc2>& lhs, const AVL<Key2, T2, Compare2, Alloc2>& rhs);
 		template <class Key2, class T2, class Compare2, class Alloc2>
@@ -247,32 +530,173 @@ namespace ft
 		key_compare		comp;
 		allocator_type	alloc;
 
+		// The comparator of every search, counted with FT_AVL_STATS
+		template <class K1, class K2>
+		bool less(const K1& lhs, const K2& rhs) const {
+			FT_AVL_COUNT(comparisons);
+			return this->comp(lhs, rhs);
+		}
+
 		// Allocation Manager
 		void deleteRoot() {
 			if (this->root)
 				this->deleteNodeAndItsDescendants(this->root);
 			this->root = NULL;
 			this->sizee = 0;
+			this->updateEnd();
 		}
+		// The node is built in place: construct() would copy a temporary node
 		node_type* createNode(const value_type& pair) {
 			node_type *ret = this->alloc.allocate(1);
-			this->alloc.construct(ret, node_type(this->comp, pair, &this->endd));
+			FT_AVL_COUNT(nodeAllocations);
+			try {
+				new (ret) node_type(pair);
+			} catch (...) {
+				this->alloc.deallocate(ret, 1);
+				throw;
+			}
+			return ret;
+		}
+		template <class U1, class U2>
+		node_type* createNode(const U1& first, const U2& second) {
+			node_type *ret = this->alloc.allocate(1);
+			FT_AVL_COUNT(nodeAllocations);
+			try {
+				new (ret) node_type(first, second);
+			} catch (...) {
+				this->alloc.deallocate(ret, 1);
+				throw;
+			}
+			return ret;
+		}
+		template <class U1, class Args>
+		node_type* createNode(piecewise_construct_t, const U1& first, const Args& args) {
+			node_type *ret = this->alloc.allocate(1);
+			FT_AVL_COUNT(nodeAllocations);
+			try {
+				new (ret) node_type(ft::piecewise_construct, first, args);
+			} catch (...) {
+				this->alloc.deallocate(ret, 1);
+				throw;
+			}
 			return ret;
 		}
 		void deleteNode(node_type *node) {
+			FT_AVL_COUNT(nodeFrees);
 			this->alloc.destroy(node);
 			this->alloc.deallocate(node, 1);
 		}
-		void deleteNodeAndItsDescendants(node_type* node) {
+		size_type deleteNodeAndItsDescendants(node_type* node) {
+			if (!node)
+				return 0;
+			size_type n = 1;
+			n += this->deleteNodeAndItsDescendants(node->left);
+			n += this->deleteNodeAndItsDescendants(node->right);
+			this->deleteNode(node);
+			return n;
+		}
+
+		// The end node is the parent of the root and points to the last node
+		void setRoot(node_type *node) {
+			this->root = node;
+			if (node)
+				node->parent = &this->endd;
+		}
+		void updateEnd() {
+			node_type *p = this->root;
+			while (p && p->right)
+				p = p->right;
+			this->endd.left = p;
+			this->endd.right = p;
+		}
+
+		// Sorted lists (linked through right) for the bulk operations
+		node_type *detachList() {
+			node_type *head = NULL;
+			this->toList(this->root, head);
+			this->root = NULL;
+			this->sizee = 0;
+			return head;
+		}
+		void toList(node_type *node, node_type *&head) { // Reverse in-order, O(height) stack
+			if (!node)
+				return;
+			this->toList(node->right, head);
+			node_type *left = node->left;
+			node->right = head;
+			node->left = NULL;
+			head = node;
+			this->toList(left, head);
+		}
+		void appendToList(node_type *&node, node_type **&tail, size_type& n) {
+			*tail = node;
+			tail = &node->right;
+			node = node->right;
+			n++;
+		}
+		void deleteList(node_type *head) {
+			while (head) {
+				node_type *next = head->right;
+				this->deleteNode(head);
+				head = next;
+			}
+		}
+		void buildFromList(node_type *head, size_type n) {
+			this->setRoot(this->buildBalanced(head, n));
+			this->sizee = n;
+			this->updateEnd();
+		}
+		node_type *buildBalanced(node_type *&head, size_type n) { // Consumes n nodes of the list
+			if (n == 0)
+				return NULL;
+			node_type *left = this->buildBalanced(head, n / 2);
+			node_type *node = head;
+			head = head->right;
+			node->left = left;
+			node->right = this->buildBalanced(head, n - n / 2 - 1);
 			if (node->left)
-				this->deleteNodeAndItsDescendants(node->left);
+				node->left->parent = node;
 			if (node->right)
-				this->deleteNodeAndItsDescendants(node->right);
-			this->deleteNode(node);
+				node->right->parent = node;
+			node->height = 1 + std::max(height(node->left), height(node->right));
+			return node;
 		}
 
 		// Utils
+		void shape(const node_type *node, int depth, shape_stats& s) const {
+			if (!node)
+				return;
+			s.nodes++;
+			s.averageDepth += depth;
+			s.maxDepth = std::max(s.maxDepth, depth);
+			int factor = height(node->left) - height(node->right);
+			if (factor >= -1 && factor <= 1)
+				s.balance[factor + 1]++;
+			else
+				s.unbalanced++;
+			this->shape(node->left, depth + 1, s);
+			this->shape(node->right, depth + 1, s);
+		}
+		int validate(const node_type *node, const node_type *&last, size_type& n, const char *&error) const { // Returns the real height
+			if (!node || error)
+				return 0;
+			if ((node->left && node->left->parent != node) || (node->right && node->right->parent != node))
+				error = "child with a wrong parent link";
+			int left = this->validate(node->left, last, n, error);
+			// comp directly: the checks do not count in the FT_AVL_STATS comparisons
+			if (!error && last && !this->comp(last->pair.first, node->pair.first))
+				error = "keys out of order";
+			last = node;
+			n++;
+			int right = this->validate(node->right, last, n, error);
+			if (!error && node->height != 1 + std::max(left, right))
+				error = "stale height";
+			if (!error && (left - right > 1 || right - left > 1))
+				error = "balance factor out of [-1, 1]";
+			return 1 + std::max(left, right);
+		}
 		node_type* copyDescendants(node_type* node, const node_type* other) {
+			node->height = other->height;
 			if (other->left) {
 				node->left = this->createNode(other->left->pair);
 				node->left->parent = node;
@@ -285,32 +709,6 @@ namespace ft
 			}
 			return node;
 		}
-		node_type *setPair(node_type *node, value_type pair) {
-			const node_type* node_addr = node;
-			node_type tmp = *node;
-			tmp.parent = node->parent;
-			this->deleteNode(node);
-			node_type *ret = this->createNode(pair);
-			*ret = tmp;
-			ret->parent = tmp.parent;
-			if (ret->left)
-				ret->left->parent = ret;
-			if (ret->right)
-				ret->right->parent = ret;
-			if (ret->parent) {
-				bool isLeftChild = (ret->parent->left == node_addr);
-				if (isLeftChild)
-					ret->parent->left = ret;
-				else
-					ret->parent->right = ret;
-			}
-			if (!this->comp(this->endd.right->pair.first, ret->pair.first)
-				&& !this->comp(ret->pair.first, this->endd.right->pair.first)) {
-				this->endd.left = ret;
-				this->endd.right = ret;
-			}
-			return ret;
-		}
 		void print(const std::string& prefix, const node_type* node, bool isLeft) {
 			if (node) {
 				std::cout << prefix;
@@ -322,79 +720,121 @@ namespace ft
 		}
 
 		/// AVL BALANCE MANAGER ///
-		// insert/erase + self-balancing
-		node_type *insertNode(node_type *node, value_type pair) {
-			// Insert
-			if (node == NULL)
-				return (this->createNode(pair));
-			if (this->comp(pair.first, node->pair.first)) {
-				node->left = insertNode(node->left, pair);
+		// Node makers of insertNode(), only called if the key is missing
+		struct PairMaker {
+			PairMaker(AVL& avl, const value_type& pair) : avl(avl), pair(pair), made(NULL) {}
+			node_type *operator()() {
+				return (this->made = this->avl.createNode(this->pair));
+			}
+			AVL&				avl;
+			const value_type&	pair;
+			node_type			*made;
+		};
+		template <class K, class Args>
+		struct ArgsMaker {
+			ArgsMaker(AVL& avl, const K& key, const Args& args) : avl(avl), key(key), args(args), made(NULL) {}
+			node_type *operator()() {
+				return (this->made = this->avl.createNode(ft::piecewise_construct, this->key, this->args));
+			}
+			AVL&		avl;
+			const K&	key;
+			const Args&	args;
+			node_type	*made;
+		};
+		template <class M>
+		struct ValueMaker {
+			ValueMaker(AVL& avl, const key_type& key, const M& mapped) : avl(avl), key(key), mapped(mapped), made(NULL) {}
+			node_type *operator()() {
+				return (this->made = this->avl.createNode(this->key, this->mapped));
+			}
+			AVL&				avl;
+			const key_type&		key;
+			const M&			mapped;
+			node_type			*made;
+		};
+		struct NodeMaker { // Links an existing node
+			NodeMaker(node_type *node) : node(node), made(NULL) {}
+			node_type *operator()() {
+				return (this->made = this->node);
+			}
+			node_type	*node;
+			node_type	*made;
+		};
+
+		template <class K, class Maker>
+		bool insertWith(const K& key, Maker& make, node_type *&position) {
+			this->setRoot(this->insertNode(this->root, key, make, position));
+			if (!make.made)
+				return false;
+			if (this->sizee == 0 || this->less(this->endd.right->pair.first, position->pair.first)) {
+				this->endd.left = position;
+				this->endd.right = position;
+			}
+			this->sizee++;
+			return true;
+		}
+		// insert + self-balancing, the rotations are only done on the way
+		// back from a new node
+		template <class K, class Maker>
+		node_type *insertNode(node_type *node, const K& key, Maker& make, node_type *&found) {
+			if (node == NULL) {
+				found = make();
+				return found;
+			}
+			if (this->less(key, node->pair.first)) {
+				node->left = insertNode(node->left, key, make, found);
 				node->left->parent = node;
 			}
-			else if (this->comp(node->pair.first, pair.first)) {
-				node->right = insertNode(node->right, pair);
+			else if (this->less(node->pair.first, key)) {
+				node->right = insertNode(node->right, key, make, found);
 				node->right->parent = node;
 			}
 			else {
-				node->pair.second = pair.second;
+				found = node;
 				return node;
 			}
-
-			// Update balance factors and balance the tree
-			node->height = 1 + std::max(height(node->left),
-										height(node->right));
-			int balanceFactor = getBalanceFactor(node);
-			if (balanceFactor > 1) {
-				if (this->comp(pair.first, node->left->pair.first))
-					return rightRotate(node);
-				else if (this->comp(node->left->pair.first, pair.first)) {
-					node->left = leftRotate(node->left);
-					return rightRotate(node);
-				}
-			}
-			if (balanceFactor < -1) {
-				if (this->comp(node->right->pair.first, pair.first))
-					return leftRotate(node);
-				else if (this->comp(pair.first, node->right->pair.first)) {
-					node->right = rightRotate(node->right);
-					return leftRotate(node);
-				}
-			}
-			return node;
+			if (!make.made) // Nothing changed below
+				return node;
+			return this->balance(node);
 		}
-		node_type *deleteNode(node_type *root, key_type key) {
-			// Delete
+		// Unlinks the node of key (without deallocating it), the nodes are relinked
+		// instead of copying the pairs, so the other nodes (and iterators) stay valid
+		node_type *unlinkNode(node_type *root, const key_type& key, node_type *&unlinked) {
 			if (root == NULL)
 				return root;
-			if (this->comp(key, root->pair.first))
-				root->left = deleteNode(root->left, key);
-			else if (this->comp(root->pair.first, key))
-				root->right = deleteNode(root->right, key);
+			if (this->less(key, root->pair.first)) {
+				root->left = unlinkNode(root->left, key, unlinked);
+				if (root->left)
+					root->left->parent = root;
+			}
+			else if (this->less(root->pair.first, key)) {
+				root->right = unlinkNode(root->right, key, unlinked);
+				if (root->right)
+					root->right->parent = root;
+			}
 			else {
-				if ((root->left == NULL) || (root->right == NULL)) {
-					node_type *temp = root->left ? root->left : root->right;
-					if (temp == NULL) {
-						temp = root;
-						root = NULL;
-					} else {
-						node_type* save_parent = temp->parent ? temp->parent->parent : NULL;
-						*root = *temp;
-						root = this->setPair(root, temp->pair);
-						root->parent = save_parent;
-					}
-					this->deleteNode(temp);
-				} else {
-					node_type *temp = root->right;
-					while (temp->left)
-						temp = temp->left;
-					root = this->setPair(root, temp->pair);
-					root->right = deleteNode(root->right,
-					temp->pair.first);
-				}
+				unlinked = root;
+				if (root->left == NULL || root->right == NULL)
+					return root->left ? root->left : root->right;
+				// The successor takes the place of root
+				node_type *successor;
+				node_type *right = this->unlinkMin(root->right, successor);
+				root = this->link(root->left, successor, right);
 			}
-			if (root == NULL)
-				return root;
-			// Update balance factors and balance the tree
+			return this->balance(root);
+		}
+		node_type *unlinkMin(node_type *node, node_type *&min) {
+			if (node->left == NULL) {
+				min = node;
+				return node->right;
+			}
+			node->left = this->unlinkMin(node->left, min);
+			if (node->left)
+				node->left->parent = node;
+			return this->balance(node);
+		}
+		// Update balance factors and balance the tree
+		node_type *balance(node_type *root) {
 			root->height = 1 + std::max(height(root->left),
 										height(root->right));
 			int balanceFactor = getBalanceFactor(root);
@@ -418,6 +858,7 @@ namespace ft
 		}
 		// Rotations
 		node_type *rightRotate(node_type *y) {
+			FT_AVL_COUNT(rightRotations);
 			node_type *x = y->left;
 			node_type *T2 = x->right;
 
@@ -434,6 +875,7 @@ namespace ft
 			return x;
 		}
 		node_type *leftRotate(node_type *x) {
+			FT_AVL_COUNT(leftRotations);
 			node_type *y = x->right;
 			node_type *T2 = y->left;
 
@@ -449,6 +891,91 @@ namespace ft
 				x->right->parent = x;
 			return y;
 		}
+
+		// Join & split of detached subtrees (the parent of the result is not set)
+		node_type *link(node_type *left, node_type *node, node_type *right) {
+			node->left = left;
+			node->right = right;
+			if (left)
+				left->parent = node;
+			if (right)
+				right->parent = node;
+			node->height = 1 + std::max(height(left), height(right));
+			return node;
+		}
+		node_type *join(node_type *left, node_type *node, node_type *right) { // left < node < right
+			if (height(left) > height(right) + 1)
+				return this->joinRight(left, node, right);
+			if (height(right) > height(left) + 1)
+				return this->joinLeft(left, node, right);
+			return this->link(left, node, right);
+		}
+		node_type *joinRight(node_type *left, node_type *node, node_type *right) {
+			node_type *sub;
+			if (height(left->right) <= height(right) + 1) {
+				sub = this->link(left->right, node, right);
+				if (height(sub) > height(left->left) + 1)
+					sub = this->rightRotate(sub);
+			} else
+				sub = this->joinRight(left->right, node, right);
+			this->link(left->left, left, sub);
+			if (height(sub) > height(left->left) + 1)
+				return this->leftRotate(left);
+			return left;
+		}
+		node_type *joinLeft(node_type *left, node_type *node, node_type *right) {
+			node_type *sub;
+			if (height(right->left) <= height(left) + 1) {
+				sub = this->link(left, node, right->left);
+				if (height(sub) > height(right->right) + 1)
+					sub = this->leftRotate(sub);
+			} else
+				sub = this->joinLeft(left, node, right->left);
+			this->link(sub, right, right->right);
+			if (height(sub) > height(right->right) + 1)
+				return this->rightRotate(right);
+			return right;
+		}
+		node_type *join(node_type *left, node_type *right) { // left < right, no middle node
+			if (!left)
+				return right;
+			if (!right)
+				return left;
+			node_type *last;
+			left = this->splitLast(left, last);
+			return this->join(left, last, right);
+		}
+		node_type *splitLast(node_type *node, node_type *&last) {
+			if (!node->right) {
+				last = node;
+				return node->left;
+			}
+			node_type *rest = this->splitLast(node->right, last);
+			return this->join(node->left, node, rest);
+		}
+		// Splits node into the keys < key and the keys > key, returns the node of key
+		node_type *split(node_type *node, const key_type& key,
+							node_type *&lower, node_type *&greater) {
+			if (!node) {
+				lower = NULL;
+				greater = NULL;
+				return NULL;
+			}
+			node_type *left = node->left, *right = node->right;
+			node_type *found;
+			if (this->less(key, node->pair.first)) {
+				found = this->split(left, key, lower, greater);
+				greater = this->join(greater, node, right);
+			} else if (this->less(node->pair.first, key)) {
+				found = this->split(right, key, lower, greater);
+				lower = this->join(left, node, lower);
+			} else {
+				lower = left;
+				greater = right;
+				found = this->link(NULL, node, NULL);
+			}
+			return found;
+		}
 		/// /////////////////// ///
 	};
 
@@ -0,0 +1,176 @@
+#ifndef ARENA_ALLOCATOR_HPP
+#define ARENA_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+namespace ft
+{
+	// Memory handed out by bumping a pointer in big chunks: nothing is freed
+	// one by one, reset() rewinds to the first chunk in O(1) and the chunks
+	// are reused by the next allocations, they are only freed by ~arena()
+	class arena
+	{
+	public:
+		explicit arena(std::size_t chunkSize = 64 * 1024)
+		: chunkSize(chunkSize), first(NULL), current(NULL), cur(NULL), end(NULL), allocated(0) {}
+		~arena() {
+			while (this->first) {
+				chunk *next = this->first->next;
+				::operator delete(this->first);
+				this->first = next;
+			}
+		}
+
+		void *allocate(std::size_t bytes, std::size_t alignment) {
+			char *p = align(this->cur, alignment);
+			if (!this->cur || p + bytes > this->end) {
+				this->nextChunk(bytes + alignment);
+				p = align(this->cur, alignment);
+			}
+			this->cur = p + bytes;
+			return p;
+		}
+		void reset() {
+			this->current = this->first;
+			if (this->first) {
+				this->cur = this->first->data();
+				this->end = this->cur + this->first->size;
+			}
+		}
+
+		// Bytes reserved from the system by the chunks
+		std::size_t capacity() const {
+			return this->allocated;
+		}
+
+	private:
+		struct chunk {
+			chunk		*next;
+			std::size_t	size;
+			double		padding;	// data() is aligned for any fundamental type
+			char *data() {
+				return reinterpret_cast<char*>(this + 1);
+			}
+		};
+
+		std::size_t	chunkSize;
+		chunk		*first;
+		chunk		*current;
+		char		*cur;		// Bump pointer in current
+		char		*end;
+		std::size_t	allocated;
+
+		arena(const arena&);
+		arena& operator=(const arena&);
+
+		static char *align(char *p, std::size_t alignment) {
+			std::size_t offset = reinterpret_cast<std::size_t>(p) % alignment;
+			return offset ? p + alignment - offset : p;
+		}
+		// Moves to the chunk after current, a chunk is inserted if it is too small
+		void nextChunk(std::size_t bytes) {
+			chunk *next = this->current ? this->current->next : this->first;
+			if (!next || next->size < bytes) {
+				std::size_t size = (bytes > this->chunkSize) ? bytes : this->chunkSize;
+				chunk *c = static_cast<chunk*>(::operator new(sizeof(chunk) + size));
+				c->size = size;
+				c->next = next;
+				if (this->current)
+					this->current->next = c;
+				else
+					this->first = c;
+				this->allocated += size;
+				next = c;
+			}
+			this->current = next;
+			this->cur = next->data();
+			this->end = this->cur + next->size;
+		}
+	};
+
+	template <class T>
+	struct alignment_of {
+		struct padded {
+			char	c;
+			T		t;
+		};
+		static const std::size_t value = sizeof(padded) - sizeof(T);
+	};
+
+	// Allocator of an arena, deallocate() is a no-op: the memory of the
+	// containers is given back all at once by arena::reset(). A default
+	// constructed arena_allocator has no arena and uses operator new
+	template <class T>
+	class arena_allocator
+	{
+	public:
+		typedef T				value_type;
+		typedef T*				pointer;
+		typedef const T*		const_pointer;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+		typedef std::size_t		size_type;
+		typedef std::ptrdiff_t	difference_type;
+
+		template <class U>
+		struct rebind {
+			typedef arena_allocator<U> other;
+		};
+
+		arena_allocator() throw() : _arena(NULL) {}
+		arena_allocator(arena& a) throw() : _arena(&a) {}
+		arena_allocator(const arena_allocator& other) throw() : _arena(other._arena) {}
+		template <class U>
+		arena_allocator(const arena_allocator<U>& other) throw() : _arena(other.get_arena()) {}
+		~arena_allocator() throw() {}
+
+		pointer allocate(size_type n, const void * = 0) {
+			if (n > this->max_size())
+				throw std::bad_alloc();
+			if (!this->_arena)
+				return static_cast<pointer>(::operator new(n * sizeof(T)));
+			return static_cast<pointer>(this->_arena->allocate(n * sizeof(T), alignment_of<T>::value));
+		}
+		void deallocate(pointer p, size_type) {
+			if (!this->_arena)
+				::operator delete(p);
+		}
+
+		void construct(pointer p, const_reference val) {
+			new (p) T(val);
+		}
+		void destroy(pointer p) {
+			p->~T();
+		}
+
+		pointer address(reference x) const {
+			return &x;
+		}
+		const_pointer address(const_reference x) const {
+			return &x;
+		}
+		size_type max_size() const throw() {
+			return size_type(-1) / sizeof(T);
+		}
+
+		arena *get_arena() const {
+			return this->_arena;
+		}
+
+	private:
+		arena	*_arena;
+	};
+
+	// The memory of an arena can only be released by the allocators of that arena
+	template <class T, class U>
+	bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) {
+		return lhs.get_arena() == rhs.get_arena();
+	}
+	template <class T, class U>
+	bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) {
+		return !(lhs == rhs);
+	}
+}
+
+#endif // ARENA_ALLOCATOR_HPP
@@ -0,0 +1,69 @@
+#ifndef EMPLACE_ARGS_HPP
+#define EMPLACE_ARGS_HPP
+
+#include <new>
+
+namespace ft
+{
+	// Arguments of an emplace, without variadic templates: the containers
+	// call operator() on their uninitialized storage, so the element is
+	// constructed in place instead of being copied from a temporary.
+	// make() returns the element, for the member initializers (see pair.hpp)
+	struct emplace_args0 {
+		template <class T>
+			void operator()(T *p) const {
+				new (p) T();
+			}
+		template <class T>
+			T make() const {
+				return T();
+			}
+	};
+
+	template <class A1>
+	struct emplace_args1 {
+		emplace_args1(const A1& a1) : a1(a1) {}
+		template <class T>
+			void operator()(T *p) const {
+				new (p) T(this->a1);
+			}
+		template <class T>
+			T make() const {
+				return T(this->a1);
+			}
+		const A1&	a1;
+	};
+
+	template <class A1, class A2>
+	struct emplace_args2 {
+		emplace_args2(const A1& a1, const A2& a2) : a1(a1), a2(a2) {}
+		template <class T>
+			void operator()(T *p) const {
+				new (p) T(this->a1, this->a2);
+			}
+		template <class T>
+			T make() const {
+				return T(this->a1, this->a2);
+			}
+		const A1&	a1;
+		const A2&	a2;
+	};
+
+	template <class A1, class A2, class A3>
+	struct emplace_args3 {
+		emplace_args3(const A1& a1, const A2& a2, const A3& a3) : a1(a1), a2(a2), a3(a3) {}
+		template <class T>
+			void operator()(T *p) const {
+				new (p) T(this->a1, this->a2, this->a3);
+			}
+		template <class T>
+			T make() const {
+				return T(this->a1, this->a2, this->a3);
+			}
+		const A1&	a1;
+		const A2&	a2;
+		const A3&	a3;
+	};
+}
+
+#endif // EMPLACE_ARGS_HPP
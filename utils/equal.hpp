@@ -0,0 +1,44 @@
+#ifndef EQUAL_HPP
+#define EQUAL_HPP
+
+#include <cstring>
+#include "is_integral.hpp"
+
+namespace ft
+{
+	template <class InputIterator1, class InputIterator2>
+	bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2) {
+		for (; first1 != last1; first1++, first2++)
+			if (!(*first1 == *first2))
+				return false;
+		return true;
+	}
+
+	namespace
+	{
+		// Integral values are equal iff their bytes are (no padding bits, a
+		// single representation per value), so memcmp can compare them
+		template <class T>
+		bool equalPointers(const T *first1, const T *last1, const T *first2,
+						   integral_constant<bool, true>) {
+			if (first1 == last1) // The pointers of an empty vector may be NULL
+				return true;
+			return std::memcmp(first1, first2, (last1 - first1) * sizeof(T)) == 0;
+		}
+		template <class T>
+		bool equalPointers(const T *first1, const T *last1, const T *first2,
+						   integral_constant<bool, false>) {
+			for (; first1 != last1; first1++, first2++)
+				if (!(*first1 == *first2))
+					return false;
+			return true;
+		}
+	}
+
+	template <class T>
+	bool equal(const T *first1, const T *last1, const T *first2) {
+		return equalPointers(first1, last1, first2, ft::is_integral<T>());
+	}
+}
+
+#endif // EQUAL_HPP
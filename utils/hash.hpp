@@ -0,0 +1,59 @@
+#ifndef HASH_HPP
+#define HASH_HPP
+
+#include <cstddef>
+#include <string>
+#include <stdint.h>
+#include "enable_if.hpp"
+#include "is_integral.hpp"
+
+namespace ft
+{
+	// Spreads the bits of x over the whole word (the finalizer of
+	// MurmurHash3), consecutive keys end far apart
+	inline std::size_t mix_bits(uint64_t x) {
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdUL;
+		x ^= x >> 33;
+		x *= 0xc4ceb9fe1a85ec53UL;
+		x ^= x >> 33;
+		return static_cast<std::size_t>(x);
+	}
+
+	// The hash of the keys of the sharded maps: the integral types, the
+	// pointers and std::string. Other keys need a hash of their own
+	template <class Key, class Enable = void>
+	struct hash;
+
+	template <class Key>
+	struct hash<Key, typename ft::enable_if<ft::is_integral<Key>::value>::type>
+	{
+		std::size_t operator()(Key key) const {
+			return mix_bits(static_cast<uint64_t>(key));
+		}
+	};
+
+	template <class T>
+	struct hash<T*>
+	{
+		std::size_t operator()(T *p) const {
+			return mix_bits(reinterpret_cast<std::size_t>(p));
+		}
+	};
+
+	// FNV-1a
+	template <>
+	struct hash<std::string>
+	{
+		std::size_t operator()(const std::string& s) const {
+			uint64_t h = 14695981039346656037UL;
+			for (std::string::size_type i = 0; i < s.size(); i++) {
+				h ^= static_cast<unsigned char>(s[i]);
+				h *= 1099511628211UL;
+			}
+			return mix_bits(h);
+		}
+	};
+}
+
+#endif // HASH_HPP
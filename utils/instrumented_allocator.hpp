@@ -0,0 +1,142 @@
+#ifndef INSTRUMENTED_ALLOCATOR_HPP
+#define INSTRUMENTED_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <memory>
+
+namespace ft
+{
+	// What went through the instrumented allocators sharing these stats,
+	// histogram[i] counts the allocations of 2^(i-1) + 1 to 2^i bytes
+	struct allocation_stats {
+		static const int	buckets = 32;
+
+		allocation_stats() {
+			this->reset();
+		}
+		void reset() {
+			this->allocations = 0;
+			this->deallocations = 0;
+			this->totalBytes = 0;
+			this->liveBytes = 0;
+			this->peakBytes = 0;
+			for (int i = 0; i < buckets; i++)
+				this->histogram[i] = 0;
+		}
+
+		void allocated(std::size_t bytes) {
+			this->allocations++;
+			this->totalBytes += bytes;
+			this->liveBytes += bytes;
+			if (this->liveBytes > this->peakBytes)
+				this->peakBytes = this->liveBytes;
+			this->histogram[bucket(bytes)]++;
+		}
+		void deallocated(std::size_t bytes) {
+			this->deallocations++;
+			this->liveBytes -= bytes;
+		}
+
+		// The last bucket also takes everything bigger
+		static int bucket(std::size_t bytes) {
+			int i = 0;
+			while (i < buckets - 1 && (std::size_t(1) << i) < bytes)
+				i++;
+			return i;
+		}
+
+		// Used by the default constructed allocators
+		static allocation_stats& global() {
+			static allocation_stats stats;
+			return stats;
+		}
+
+		std::size_t	allocations;
+		std::size_t	deallocations;
+		std::size_t	totalBytes;
+		std::size_t	liveBytes;
+		std::size_t	peakBytes;
+		std::size_t	histogram[buckets];
+	};
+
+	// Wraps Alloc and counts its allocations in an allocation_stats, the
+	// rebound copies (the nodes of a map, the block map of a deque) count
+	// in the same stats
+	template <class T, class Alloc = std::allocator<T> >
+	class instrumented_allocator
+	{
+	public:
+		typedef T				value_type;
+		typedef T*				pointer;
+		typedef const T*		const_pointer;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+		typedef std::size_t		size_type;
+		typedef std::ptrdiff_t	difference_type;
+		typedef Alloc			inner_allocator_type;
+
+		template <class U>
+		struct rebind {
+			typedef instrumented_allocator<U, typename Alloc::template rebind<U>::other> other;
+		};
+
+		instrumented_allocator() throw() : _stats(&allocation_stats::global()), _inner() {}
+		instrumented_allocator(allocation_stats& stats, const Alloc& inner = Alloc()) throw()
+			: _stats(&stats), _inner(inner) {}
+		instrumented_allocator(const instrumented_allocator& other) throw()
+			: _stats(other._stats), _inner(other._inner) {}
+		template <class U, class A>
+		instrumented_allocator(const instrumented_allocator<U, A>& other) throw()
+			: _stats(&other.stats()), _inner(other.inner_allocator()) {}
+		~instrumented_allocator() throw() {}
+
+		pointer allocate(size_type n, const void *hint = 0) {
+			pointer p = this->_inner.allocate(n, hint);
+			this->_stats->allocated(n * sizeof(T));
+			return p;
+		}
+		void deallocate(pointer p, size_type n) {
+			this->_inner.deallocate(p, n);
+			this->_stats->deallocated(n * sizeof(T));
+		}
+
+		void construct(pointer p, const_reference val) {
+			this->_inner.construct(p, val);
+		}
+		void destroy(pointer p) {
+			this->_inner.destroy(p);
+		}
+
+		pointer address(reference x) const {
+			return &x;
+		}
+		const_pointer address(const_reference x) const {
+			return &x;
+		}
+		size_type max_size() const throw() {
+			return this->_inner.max_size();
+		}
+
+		allocation_stats& stats() const {
+			return *this->_stats;
+		}
+		const Alloc& inner_allocator() const {
+			return this->_inner;
+		}
+
+	private:
+		allocation_stats	*_stats;
+		Alloc				_inner;
+	};
+
+	template <class T, class A1, class U, class A2>
+	bool operator==(const instrumented_allocator<T, A1>& lhs, const instrumented_allocator<U, A2>& rhs) {
+		return &lhs.stats() == &rhs.stats() && lhs.inner_allocator() == rhs.inner_allocator();
+	}
+	template <class T, class A1, class U, class A2>
+	bool operator!=(const instrumented_allocator<T, A1>& lhs, const instrumented_allocator<U, A2>& rhs) {
+		return !(lhs == rhs);
+	}
+}
+
+#endif // INSTRUMENTED_ALLOCATOR_HPP
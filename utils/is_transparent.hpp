@@ -0,0 +1,43 @@
+#ifndef IS_TRANSPARENT_HPP
+#define IS_TRANSPARENT_HPP
+
+#include "is_integral.hpp"
+
+namespace ft
+{
+	namespace
+	{
+		template <class Compare>
+		struct has_is_transparent {
+			typedef char				yes;
+			typedef struct { char c[2]; }	no;
+
+			template <class U>
+			static yes test(typename U::is_transparent*);
+			template <class U>
+			static no test(...);
+
+			static const bool value = (sizeof(test<Compare>(NULL)) == sizeof(yes));
+		};
+	}
+
+	// True if Compare declares is_transparent, i.e. it can compare the keys
+	// with other types. K is unused: it only makes the value depend on the
+	// lookup type, so that enable_if discards the overload instead of failing
+	template <class Compare, class K = void>
+	struct is_transparent
+	: public integral_constant<bool, has_is_transparent<Compare>::value> {};
+
+	// Transparent std::less, e.g. map<std::string, T, transparent_less>
+	// can be searched with a const char* without building a std::string
+	struct transparent_less {
+		typedef void is_transparent;
+
+		template <class T, class U>
+		bool operator()(const T& lhs, const U& rhs) const {
+			return lhs < rhs;
+		}
+	};
+}
+
+#endif // IS_TRANSPARENT_HPP
@@ -37,6 +37,26 @@ namespace ft
 		typedef const T&						reference;
 		typedef std::random_access_iterator_tag	iterator_category;
 	};
+
+	// Distance, in O(1) for random access iterators
+	template <class InputIterator>
+	typename iterator_traits<InputIterator>::difference_type
+	distance(InputIterator first, InputIterator last, std::input_iterator_tag) {
+		typename iterator_traits<InputIterator>::difference_type n = 0;
+		for (; first != last; first++)
+			n++;
+		return n;
+	}
+	template <class RandomAccessIterator>
+	typename iterator_traits<RandomAccessIterator>::difference_type
+	distance(RandomAccessIterator first, RandomAccessIterator last, std::random_access_iterator_tag) {
+		return last - first;
+	}
+	template <class InputIterator>
+	typename iterator_traits<InputIterator>::difference_type
+	distance(InputIterator first, InputIterator last) {
+		return ft::distance(first, last, typename iterator_traits<InputIterator>::iterator_category());
+	}
 }
 
 #endif // ITERATOR_TRAITS
@@ -1,6 +1,18 @@
 #ifndef LEXICOGRAPHICAL_COMPARE_HPP
 #define LEXICOGRAPHICAL_COMPARE_HPP
 
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+#ifdef __AVX2__
+# include <immintrin.h>
+#endif
+#include "is_integral.hpp"
+#include "../iterators/vector_iterator.hpp"
+
 namespace ft
 {
 	template <class InputIterator1, class InputIterator2>
@@ -31,6 +43,101 @@ namespace ft
 		}
 		return (first2 != last2);
 	}
+
+	namespace
+	{
+		// Index of the first differing byte of two buffers of n bytes (n if
+		// none), by 32 bytes with AVX2, by 16 with SSE2, then byte by byte
+		inline std::size_t mismatchBytes(const unsigned char *a, const unsigned char *b, std::size_t n) {
+			std::size_t i = 0;
+#ifdef __AVX2__
+			for (; i + 32 <= n; i += 32) {
+				__m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+				__m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+				unsigned int diff = ~static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+				if (diff)
+					return i + __builtin_ctz(diff);
+			}
+#endif
+#ifdef __SSE2__
+			for (; i + 16 <= n; i += 16) {
+				__m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+				__m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+				unsigned int diff = ~static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb))) & 0xFFFF;
+				if (diff)
+					return i + __builtin_ctz(diff);
+			}
+#endif
+			while (i < n && a[i] == b[i])
+				i++;
+			return i;
+		}
+
+		// Integral ranges: the first differing element is the one holding the
+		// first differing byte, only that element is compared by value
+		// (memcmp's byte order is not the order of signed or multi-byte values)
+		template <class T>
+		bool lexicographicalPointers(const T *first1, const T *last1,
+									 const T *first2, const T *last2,
+									 integral_constant<bool, true>) {
+			std::size_t n1 = last1 - first1;
+			std::size_t n2 = last2 - first2;
+			std::size_t n = std::min(n1, n2);
+			if (n == 0) // The pointers of an empty vector may be NULL
+				return n1 < n2;
+			std::size_t i = mismatchBytes(reinterpret_cast<const unsigned char*>(first1),
+										  reinterpret_cast<const unsigned char*>(first2),
+										  n * sizeof(T)) / sizeof(T);
+			if (i == n)
+				return n1 < n2;
+			return first1[i] < first2[i];
+		}
+		template <class T>
+		bool lexicographicalPointers(const T *first1, const T *last1,
+									 const T *first2, const T *last2,
+									 integral_constant<bool, false>) {
+			return ft::lexicographical_compare<const T*, const T*>(first1, last1, first2, last2);
+		}
+		// Bytes are ordered as memcmp orders them
+		inline bool lexicographicalPointers(const unsigned char *first1, const unsigned char *last1,
+											const unsigned char *first2, const unsigned char *last2,
+											integral_constant<bool, true>) {
+			std::size_t n1 = last1 - first1;
+			std::size_t n2 = last2 - first2;
+			if (n1 == 0 || n2 == 0) // The pointers of an empty vector may be NULL
+				return n1 < n2;
+			int cmp = std::memcmp(first1, first2, std::min(n1, n2));
+			if (cmp)
+				return cmp < 0;
+			return n1 < n2;
+		}
+
+		// T is deduced without its const from both ranges, pointers to
+		// different types are compared element by element
+		template <class T>
+		bool comparePointers(const T *first1, const T *last1, const T *first2, const T *last2) {
+			return lexicographicalPointers(first1, last1, first2, last2, ft::is_integral<T>());
+		}
+		template <class T, class U>
+		bool comparePointers(const T *first1, const T *last1, const U *first2, const U *last2) {
+			return ft::lexicographical_compare<const T*, const U*>(first1, last1, first2, last2);
+		}
+	}
+
+	// Every pointer range, const or not, goes through comparePointers
+	template <class T, class U>
+	bool lexicographical_compare(T *first1, T *last1, U *first2, U *last2) {
+		return comparePointers(first1, last1, first2, last2);
+	}
+
+	// Contiguous ranges of vector_iterators are compared as raw pointers
+	template <class T, class U>
+	bool lexicographical_compare(vector_iterator<T> first1, vector_iterator<T> last1,
+								 vector_iterator<U> first2, vector_iterator<U> last2) {
+		const T *p1 = first1.base();
+		const U *p2 = first2.base();
+		return ft::lexicographical_compare(p1, p1 + (last1 - first1), p2, p2 + (last2 - first2));
+	}
 }
 
 #endif // LEXICOGRAPHICAL_COMPARE_HPP
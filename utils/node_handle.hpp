@@ -0,0 +1,87 @@
+#ifndef NODE_HANDLE_HPP
+#define NODE_HANDLE_HPP
+
+#include "pair.hpp"
+
+namespace ft
+{
+	template <class Key, class T, class Compare, class Alloc>
+	class map;
+
+	// Owns a node extracted from a map, until it is inserted in another one.
+	// As with std::auto_ptr, copying a handle transfers the ownership of the node.
+	template <class Key, class T, class Node, class NodeAlloc>
+	class map_node_handle
+	{
+	public:
+		typedef Key								key_type;
+		typedef T								mapped_type;
+		typedef ft::pair<const key_type, T>		value_type;
+		typedef NodeAlloc						allocator_type;
+
+		map_node_handle() : node(NULL), alloc() {}
+		map_node_handle(const map_node_handle& other)
+		: node(other.release()), alloc(other.alloc) {}
+		map_node_handle& operator=(const map_node_handle& other) {
+			if (this != &other) {
+				this->reset();
+				this->alloc = other.alloc;
+				this->node = other.release();
+			}
+			return *this;
+		}
+		~map_node_handle() {
+			this->reset();
+		}
+
+		bool empty() const {
+			return this->node == NULL;
+		}
+		const key_type& key() const {
+			return this->node->pair.first;
+		}
+		mapped_type& mapped() const {
+			return this->node->pair.second;
+		}
+		value_type& value() const {
+			return this->node->pair;
+		}
+		allocator_type get_allocator() const {
+			return this->alloc;
+		}
+
+		void swap(map_node_handle& other) {
+			Node *tmp = this->node;
+			this->node = other.node;
+			other.node = tmp;
+			allocator_type tmp_alloc = this->alloc;
+			this->alloc = other.alloc;
+			other.alloc = tmp_alloc;
+		}
+
+	private:
+		template <class Key2, class T2, class Compare2, class Alloc2>
+		friend class map;
+
+		map_node_handle(Node *node, const allocator_type& alloc)
+		: node(node), alloc(alloc) {}
+
+		Node *release() const {
+			Node *ret = this->node;
+			this->node = NULL;
+			return ret;
+		}
+		void reset() {
+			if (this->node) {
+				this->alloc.destroy(this->node);
+				this->alloc.deallocate(this->node, 1);
+				this->node = NULL;
+			}
+		}
+
+		mutable Node	*node;
+		allocator_type	alloc;
+	};
+}
+
+#endif // NODE_HANDLE_HPP
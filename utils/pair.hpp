@@ -3,6 +3,10 @@
 
 namespace ft
 {
+	// Tag of the pair constructor building second from emplace arguments
+	struct piecewise_construct_t {};
+	const piecewise_construct_t piecewise_construct = piecewise_construct_t();
+
 	template <class T1, class T2>
 	struct pair
 	{
@@ -21,6 +25,12 @@ namespace ft
 
 		pair(const first_type& a, const second_type& b) :
 		first(a), second(b) {}
+
+		// second is initialized by the value returned by args.make(), which
+		// the copy elision constructs directly in the pair
+		template <class Args>
+		pair(piecewise_construct_t, const first_type& a, const Args& args) :
+		first(a), second(args.template make<second_type>()) {}
 	};
 
 	// Relational operators
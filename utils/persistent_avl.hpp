@@ -0,0 +1,254 @@
+#ifndef PERSISTENT_AVL_HPP
+#define PERSISTENT_AVL_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <new>
+#include "pair.hpp"
+
+namespace ft
+{
+	// Node of the persistent AVL trees: a published node is never changed,
+	// the versions of a tree share their subtrees through reference counts
+	template <class T>
+	struct persistent_node {
+		persistent_node(const T& pair, unsigned long version)
+		: pair(pair), left(NULL), right(NULL), refs(1), height(1), size(1), version(version) {}
+
+		T				pair;
+		persistent_node	*left;
+		persistent_node	*right;
+		long			refs;		// Parents and roots holding the node, changed atomically
+		int				height;
+		std::size_t		size;		// Nodes of the subtree
+		unsigned long	version;	// Write which built the node, the only one which can change it
+	};
+
+	// Stamps of the writes, unique over all the trees
+	inline unsigned long next_write_version() {
+		static unsigned long version = 0;
+		return __atomic_add_fetch(&version, 1, __ATOMIC_RELAXED);
+	}
+
+	// The operations of the persistent trees on their roots: an update
+	// copies the path to the changed node and returns the root of the new
+	// version, the other subtrees are shared and the old root stays valid.
+	// The rebalancing is the one of AVL.hpp, the shared nodes it moves are
+	// copied first. Reads and reference counts are thread safe, the updates
+	// of one persistent_avl must not run concurrently. The nodes are freed
+	// by the thread dropping their last reference, Alloc must allow it
+	template <class Key, class T, class Compare, class Alloc>
+	class persistent_avl
+	{
+	public:
+		typedef				Key											key_type;
+		typedef typename	ft::pair<const Key, T>						value_type;
+		typedef				persistent_node<value_type>					node_type;
+		typedef typename	Alloc::template rebind<node_type>::other	allocator_type;
+		typedef				std::size_t									size_type;
+
+		persistent_avl(const Compare& comp, const allocator_type& alloc) : comp(comp), alloc(alloc), version(0) {}
+
+		// The caller owns one reference to every root it gets
+		static node_type *retain(node_type *node) {
+			if (node)
+				__atomic_add_fetch(&node->refs, 1, __ATOMIC_RELAXED);
+			return node;
+		}
+		// The last reference frees the node, from any thread
+		void release(node_type *node) const {
+			allocator_type alloc(this->alloc);
+			while (node && __atomic_sub_fetch(&node->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+				node_type *right = node->right;
+				this->release(node->left);
+				alloc.destroy(node);
+				alloc.deallocate(node, 1);
+				node = right;
+			}
+		}
+
+		static size_type size(const node_type *root) {
+			return root ? root->size : 0;
+		}
+		static int height(const node_type *node) {
+			return node ? node->height : 0;
+		}
+
+		template <class K>
+		const node_type *find(const node_type *root, const K& key) const {
+			while (root) {
+				if (this->comp(key, root->pair.first))
+					root = root->left;
+				else if (this->comp(root->pair.first, key))
+					root = root->right;
+				else
+					return root;
+			}
+			return NULL;
+		}
+
+		// inserted: whether the key was missing; with assign, the value of
+		// an existing key is replaced. Returns root retained if nothing changed
+		node_type *insert(node_type *root, const value_type& pair, bool assign, bool& inserted) {
+			this->version = next_write_version();
+			inserted = false;
+			bool changed = false;
+			node_type *updated = this->insertNode(root, pair, assign, changed, inserted);
+			return changed ? updated : retain(root);
+		}
+		template <class K>
+		node_type *erase(node_type *root, const K& key, bool& erased) {
+			this->version = next_write_version();
+			erased = false;
+			node_type *updated = this->eraseNode(root, key, erased);
+			return erased ? updated : retain(root);
+		}
+
+		Compare key_comp() const {
+			return this->comp;
+		}
+		allocator_type get_allocator() const {
+			return this->alloc;
+		}
+
+	private:
+		Compare			comp;
+		allocator_type	alloc;
+		unsigned long	version;	// Of the running update
+
+		// The new nodes belong to the running update until the root is returned
+		node_type *create(const value_type& pair, node_type *left, node_type *right) {
+			node_type *node = this->alloc.allocate(1);
+			try {
+				new (node) node_type(pair, this->version);
+			} catch (...) {
+				this->alloc.deallocate(node, 1);
+				this->release(left);
+				this->release(right);
+				throw;
+			}
+			node->left = left;
+			node->right = right;
+			this->update(node);
+			return node;
+		}
+		// The node if the running update built it, a copy otherwise: the
+		// reference of its parent moves to the copy
+		node_type *writable(node_type *node) {
+			if (node->version == this->version)
+				return node;
+			node_type *copy = this->create(node->pair, retain(node->left), retain(node->right));
+			this->release(node);
+			return copy;
+		}
+		void update(node_type *node) {
+			node->height = 1 + std::max(height(node->left), height(node->right));
+			node->size = 1 + size(node->left) + size(node->right);
+		}
+
+		// NULL with changed false when the tree stays the same
+		node_type *insertNode(node_type *node, const value_type& pair, bool assign, bool& changed, bool& inserted) {
+			if (!node) {
+				changed = true;
+				inserted = true;
+				return this->create(pair, NULL, NULL);
+			}
+			if (this->comp(pair.first, node->pair.first)) {
+				node_type *left = this->insertNode(node->left, pair, assign, changed, inserted);
+				if (!changed)
+					return NULL;
+				return this->balance(this->create(node->pair, left, retain(node->right)));
+			}
+			if (this->comp(node->pair.first, pair.first)) {
+				node_type *right = this->insertNode(node->right, pair, assign, changed, inserted);
+				if (!changed)
+					return NULL;
+				return this->balance(this->create(node->pair, retain(node->left), right));
+			}
+			if (!assign)
+				return NULL;
+			changed = true;
+			return this->create(pair, retain(node->left), retain(node->right));
+		}
+		template <class K>
+		node_type *eraseNode(node_type *node, const K& key, bool& erased) {
+			if (!node)
+				return NULL;
+			if (this->comp(key, node->pair.first)) {
+				node_type *left = this->eraseNode(node->left, key, erased);
+				if (!erased)
+					return NULL;
+				return this->balance(this->create(node->pair, left, retain(node->right)));
+			}
+			if (this->comp(node->pair.first, key)) {
+				node_type *right = this->eraseNode(node->right, key, erased);
+				if (!erased)
+					return NULL;
+				return this->balance(this->create(node->pair, retain(node->left), right));
+			}
+			erased = true;
+			if (!node->left)
+				return retain(node->right);
+			if (!node->right)
+				return retain(node->left);
+			// The successor is copied in the place of node
+			const node_type *min;
+			node_type *right = this->eraseMin(node->right, min);
+			return this->balance(this->create(min->pair, retain(node->left), right));
+		}
+		node_type *eraseMin(node_type *node, const node_type *&min) {
+			if (!node->left) {
+				min = node;
+				return retain(node->right);
+			}
+			node_type *left = this->eraseMin(node->left, min);
+			return this->balance(this->create(node->pair, left, retain(node->right)));
+		}
+
+		// node belongs to the running update and is released if a copy throws:
+		// every child is assigned as soon as it is copied, node stays whole
+		node_type *balance(node_type *node) {
+			try {
+				int factor = height(node->left) - height(node->right);
+				if (factor > 1) {
+					if (height(node->left->left) < height(node->left->right)) {
+						node->left = this->writable(node->left);
+						node->left = this->rotateLeft(node->left);
+					}
+					return this->rotateRight(node);
+				}
+				if (factor < -1) {
+					if (height(node->right->right) < height(node->right->left)) {
+						node->right = this->writable(node->right);
+						node->right = this->rotateRight(node->right);
+					}
+					return this->rotateLeft(node);
+				}
+			} catch (...) {
+				this->release(node);
+				throw;
+			}
+			return node;
+		}
+		node_type *rotateRight(node_type *y) {
+			y->left = this->writable(y->left);
+			node_type *x = y->left;
+			y->left = x->right;
+			x->right = y;
+			this->update(y);
+			this->update(x);
+			return x;
+		}
+		node_type *rotateLeft(node_type *x) {
+			x->right = this->writable(x->right);
+			node_type *y = x->right;
+			x->right = y->left;
+			y->left = x;
+			this->update(x);
+			this->update(y);
+			return y;
+		}
+	};
+}
+
+#endif // PERSISTENT_AVL_HPP